@@ -30,6 +30,9 @@ else()
     set(CMAKE_${lang}_COMPILE_OPTIONS_PIE "-fPIE")
     set(CMAKE_INCLUDE_SYSTEM_FLAG_${lang} "-isystem ")
     set(CMAKE_${lang}_COMPILE_OPTIONS_VISIBILITY "-fvisibility=")
+    if(CMAKE_${lang}_PCH_EXTENSION)
+      set(CMAKE_${lang}_PCH_EXTENSION .pch)
+    endif()
     if(CMAKE_${lang}_COMPILER_VERSION VERSION_LESS 3.4.0)
       set(CMAKE_${lang}_COMPILE_OPTIONS_TARGET "-target ")
       set(CMAKE_${lang}_COMPILE_OPTIONS_EXTERNAL_TOOLCHAIN "-gcc-toolchain ")
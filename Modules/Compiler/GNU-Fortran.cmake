@@ -11,5 +11,9 @@ set(CMAKE_Fortran_FLAGS_RELEASE_INIT "-O3")
 # No -isystem for Fortran because it will not find .mod files.
 unset(CMAKE_INCLUDE_SYSTEM_FLAG_Fortran)
 
+# No depfiles for Fortran because gfortran writes them only when it
+# preprocesses the source.  Ninja scans Fortran sources instead.
+unset(CMAKE_DEPFILE_FLAGS_Fortran)
+
 # Fortran-specific feature flags.
 set(CMAKE_Fortran_MODDIR_FLAG -J)
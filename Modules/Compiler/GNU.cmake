@@ -42,6 +42,17 @@ macro(__compiler_gnu lang)
     # internally, as it ought to.  Work around this bug by setting -MT here
     # even though it isn't strictly necessary.
     set(CMAKE_DEPFILE_FLAGS_${lang} "-MD -MT <OBJECT> -MF <DEPFILE>")
+    set(CMAKE_${lang}_DEPFILE_FORMAT gcc)
+  endif()
+
+  # Precompiled headers are built by compiling the header itself and
+  # are found next to the header included from the command line.
+  set(__pch_header_C c-header)
+  set(__pch_header_CXX c++-header)
+  if(__pch_header_${lang})
+    set(CMAKE_${lang}_PCH_EXTENSION .gch)
+    set(CMAKE_${lang}_COMPILE_OPTIONS_CREATE_PCH "-x ${__pch_header_${lang}}")
+    set(CMAKE_${lang}_COMPILE_OPTIONS_USE_PCH "-Winvalid-pch -include <PCH_HEADER>")
   endif()
 
   # Initial configuration flags.
@@ -131,6 +131,226 @@ private:
   double TimeOut;
 };
 
+//----------------------------------------------------------------------
+// Run coverage tool commands with up to a given number of them at a
+// time.  Finished jobs are handed back in the order they were added so
+// that results are merged exactly as a serial run would merge them.  A
+// job is not started while an earlier job with the same working
+// directory has not been handed back and released, because the tools
+// write their output files into the working directory.
+class cmCTestCoverageHandlerJobQueue
+{
+public:
+  struct Job
+  {
+    std::string File;
+    std::string Command;
+    std::string Directory;
+    std::string Output;
+    std::string Errors;
+    int RetVal;
+    bool Result;
+  };
+
+  cmCTestCoverageHandlerJobQueue(size_t maxRunning);
+  ~cmCTestCoverageHandlerJobQueue();
+
+  /** Number of jobs that may be in flight at once.  Jobs whose index
+      differs by at least this amount are never in flight together.  */
+  size_t GetWindow() const { return this->Window; }
+
+  void AddJob(std::string const& file, std::string const& command,
+              std::string const& dir);
+
+  /** Release the job returned by the previous call and wait for the
+      next job in order to finish.  Returns 0 when all jobs are done.  */
+  Job* NextFinishedJob();
+
+private:
+  bool IsDirectoryBusy(size_t index) const;
+  void StartJob(size_t index);
+  bool PollJob(size_t index, double timeout);
+  void FinishJob(size_t index);
+
+  size_t MaxRunning;
+  size_t Window;
+  size_t Running;
+  size_t NextToStart;
+  size_t NextToReturn;
+  size_t Released;
+  std::vector<Job> Jobs;
+  std::vector<cmsysProcess*> Processes;
+  std::vector<bool> Finished;
+};
+
+//----------------------------------------------------------------------
+cmCTestCoverageHandlerJobQueue
+::cmCTestCoverageHandlerJobQueue(size_t maxRunning):
+  MaxRunning(maxRunning < 1 ? 1 : maxRunning),
+  Running(0), NextToStart(0), NextToReturn(0), Released(0)
+{
+  // Let jobs finish ahead of a slow one when running in parallel.
+  this->Window = this->MaxRunning == 1 ? 1 : 2 * this->MaxRunning;
+}
+
+//----------------------------------------------------------------------
+cmCTestCoverageHandlerJobQueue::~cmCTestCoverageHandlerJobQueue()
+{
+  for(std::vector<cmsysProcess*>::iterator i = this->Processes.begin();
+      i != this->Processes.end(); ++i)
+    {
+    if(*i)
+      {
+      cmsysProcess_Kill(*i);
+      cmsysProcess_Delete(*i);
+      }
+    }
+}
+
+//----------------------------------------------------------------------
+void cmCTestCoverageHandlerJobQueue::AddJob(std::string const& file,
+                                            std::string const& command,
+                                            std::string const& dir)
+{
+  Job job;
+  job.File = file;
+  job.Command = command;
+  job.Directory = dir;
+  job.RetVal = 0;
+  job.Result = false;
+  this->Jobs.push_back(job);
+  this->Processes.push_back(0);
+  this->Finished.push_back(false);
+}
+
+//----------------------------------------------------------------------
+cmCTestCoverageHandlerJobQueue::Job*
+cmCTestCoverageHandlerJobQueue::NextFinishedJob()
+{
+  this->Released = this->NextToReturn;
+  if(this->NextToReturn >= this->Jobs.size())
+    {
+    return 0;
+    }
+  for(;;)
+    {
+    while(this->NextToStart < this->Jobs.size() &&
+          this->Running < this->MaxRunning &&
+          this->NextToStart < this->Released + this->Window &&
+          !this->IsDirectoryBusy(this->NextToStart))
+      {
+      this->StartJob(this->NextToStart++);
+      }
+    if(this->Finished[this->NextToReturn])
+      {
+      return &this->Jobs[this->NextToReturn++];
+      }
+    // Block briefly on the job needed next and drain the others.
+    for(size_t i = this->NextToReturn; i < this->NextToStart; ++i)
+      {
+      if(this->Processes[i] &&
+         this->PollJob(i, i == this->NextToReturn ? 0.05 : 0))
+        {
+        this->FinishJob(i);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------
+bool cmCTestCoverageHandlerJobQueue::IsDirectoryBusy(size_t index) const
+{
+  for(size_t i = this->Released; i < index; ++i)
+    {
+    if(this->Jobs[i].Directory == this->Jobs[index].Directory)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------
+void cmCTestCoverageHandlerJobQueue::StartJob(size_t index)
+{
+  Job& job = this->Jobs[index];
+  std::vector<std::string> args =
+    cmSystemTools::ParseArguments(job.Command.c_str());
+  std::vector<const char*> argv;
+  for(std::vector<std::string>::const_iterator a = args.begin();
+      a != args.end(); ++a)
+    {
+    argv.push_back(a->c_str());
+    }
+  argv.push_back(0);
+
+  cmsysProcess* cp = cmsysProcess_New();
+  cmsysProcess_SetCommand(cp, &*argv.begin());
+  cmsysProcess_SetWorkingDirectory(cp, job.Directory.c_str());
+  if(cmSystemTools::GetRunCommandHideConsole())
+    {
+    cmsysProcess_SetOption(cp, cmsysProcess_Option_HideWindow, 1);
+    }
+  cmsysProcess_Execute(cp);
+  this->Processes[index] = cp;
+  ++this->Running;
+}
+
+//----------------------------------------------------------------------
+bool cmCTestCoverageHandlerJobQueue::PollJob(size_t index, double timeout)
+{
+  Job& job = this->Jobs[index];
+  char* data;
+  int length;
+  for(;;)
+    {
+    switch(cmsysProcess_WaitForData(this->Processes[index], &data, &length,
+                                    &timeout))
+      {
+      case cmsysProcess_Pipe_STDOUT:
+        job.Output.append(data, length);
+        break;
+      case cmsysProcess_Pipe_STDERR:
+        job.Errors.append(data, length);
+        break;
+      case cmsysProcess_Pipe_Timeout:
+        return false;
+      default:
+        return true;
+      }
+    }
+}
+
+//----------------------------------------------------------------------
+void cmCTestCoverageHandlerJobQueue::FinishJob(size_t index)
+{
+  Job& job = this->Jobs[index];
+  cmsysProcess* cp = this->Processes[index];
+  cmsysProcess_WaitForExit(cp, 0);
+  job.Result = true;
+  switch(cmsysProcess_GetState(cp))
+    {
+    case cmsysProcess_State_Exited:
+      job.RetVal = cmsysProcess_GetExitValue(cp);
+      break;
+    case cmsysProcess_State_Exception:
+      job.Errors += cmsysProcess_GetExceptionString(cp);
+      job.Result = false;
+      break;
+    case cmsysProcess_State_Error:
+      job.Errors += cmsysProcess_GetErrorString(cp);
+      job.Result = false;
+      break;
+    default:
+      job.Errors += "Process terminated unexpectedly";
+      job.Result = false;
+      break;
+    }
+  cmsysProcess_Delete(cp);
+  this->Processes[index] = 0;
+  this->Finished[index] = true;
+  --this->Running;
+}
 
 //----------------------------------------------------------------------
 
@@ -1133,38 +1353,54 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
 
   // files is a list of *.da and *.gcda files with coverage data in them.
   // These are binary files that you give as input to gcov so that it will
-  // give us text output we can analyze to summarize coverage.
+  // give us text output we can analyze to summarize coverage.  Run gcov
+  // on several of them at once, each job in its own directory because
+  // gcov writes its .gcov files into the working directory and files
+  // for shared headers would collide.
   //
+  cmCTestCoverageHandlerJobQueue queue(this->CTest->GetParallelLevel());
   for ( it = files.begin(); it != files.end(); ++ it )
     {
-    cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
-      this->Quiet);
-
-    // Call gcov to get coverage data for this *.gcda file:
-    //
     std::string fileDir = cmSystemTools::GetFilenamePath(*it);
     std::string command = "\"" + gcovCommand + "\" " +
       gcovExtraFlags + " " +
       "-o \"" + fileDir + "\" " +
       "\"" + *it + "\"";
+    std::string jobDir = tempDir;
+    if ( queue.GetWindow() > 1 )
+      {
+      std::ostringstream slot;
+      slot << tempDir << "/"
+           << static_cast<size_t>(it - files.begin()) % queue.GetWindow();
+      jobDir = slot.str();
+      cmSystemTools::MakeDirectory(jobDir.c_str());
+      }
+    queue.AddJob(*it, command, jobDir);
+    }
+
+  cmCTestCoverageHandlerJobQueue::Job* job;
+  while ( (job = queue.NextFinishedJob()) != 0 )
+    {
+    cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
+      this->Quiet);
+
+    std::string fileDir = cmSystemTools::GetFilenamePath(job->File);
+    std::string const& command = job->Command;
 
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT, command.c_str()
       << std::endl, this->Quiet);
 
-    std::string output = "";
-    std::string errors = "";
-    int retVal = 0;
+    std::string const& output = job->Output;
+    std::string const& errors = job->Errors;
+    int retVal = job->RetVal;
     *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
     *cont->OFS << "  Command: " << command << std::endl;
-    int res = this->CTest->RunCommand(command.c_str(), &output, &errors,
-      &retVal, tempDir.c_str(), 0 /*this->TimeOut*/);
-
     *cont->OFS << "  Output: " << output << std::endl;
     *cont->OFS << "  Errors: " << errors << std::endl;
-    if ( ! res )
+    if ( ! job->Result )
       {
       cmCTestLog(this->CTest, ERROR_MESSAGE,
-        "Problem running coverage on file: " << *it << std::endl);
+        "Problem running coverage on file: " << job->File << std::endl);
       cmCTestLog(this->CTest, ERROR_MESSAGE,
         "Command produced error: " << errors << std::endl);
       cont->Error ++;
@@ -1173,7 +1409,7 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
     if ( retVal != 0 )
       {
       cmCTestLog(this->CTest, ERROR_MESSAGE, "Coverage command returned: "
-        << retVal << " while processing: " << *it << std::endl);
+        << retVal << " while processing: " << job->File << std::endl);
       cmCTestLog(this->CTest, ERROR_MESSAGE,
         "Command produced error: " << cont->Error << std::endl);
       }
@@ -1361,7 +1597,12 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
         cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
           "   in gcovFile: " << gcovFile << std::endl, this->Quiet);
 
-        cmsys::ifstream ifile(gcovFile.c_str());
+        std::string gcovPath = gcovFile;
+        if ( !cmSystemTools::FileIsFullPath(gcovPath.c_str()) )
+          {
+          gcovPath = job->Directory + "/" + gcovFile;
+          }
+        cmsys::ifstream ifile(gcovPath.c_str());
         if ( ! ifile )
           {
           cmCTestLog(this->CTest, ERROR_MESSAGE, "Cannot open file: "
@@ -1555,35 +1796,42 @@ int cmCTestCoverageHandler::HandleLCovCoverage(
   static_cast<void>(locale_C);
 
   // In intel compiler we have to call codecov only once in each executable
-  // directory. It collects all *.dyn files to generate .dpi file.
+  // directory. It collects all *.dyn files to generate .dpi file.  Runs
+  // in different directories may proceed in parallel.
+  cmCTestCoverageHandlerJobQueue queue(this->CTest->GetParallelLevel());
   for ( it = files.begin(); it != files.end(); ++ it )
     {
-    cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
-      this->Quiet);
     std::string fileDir = cmSystemTools::GetFilenamePath(*it);
-    cmSystemTools::ChangeDirectory(fileDir);
     std::string command = "\"" + lcovCommand + "\" " +
       lcovExtraFlags + " ";
+    queue.AddJob(*it, command, fileDir);
+    }
+
+  cmCTestCoverageHandlerJobQueue::Job* job;
+  while ( (job = queue.NextFinishedJob()) != 0 )
+    {
+    cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
+      this->Quiet);
+    std::string const& fileDir = job->Directory;
+    cmSystemTools::ChangeDirectory(fileDir);
+    std::string const& command = job->Command;
 
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
       "Current coverage dir: " << fileDir << std::endl, this->Quiet);
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT, command.c_str()
       << std::endl, this->Quiet);
 
-    std::string output = "";
-    std::string errors = "";
-    int retVal = 0;
+    std::string const& output = job->Output;
+    std::string const& errors = job->Errors;
+    int retVal = job->RetVal;
     *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
     *cont->OFS << "  Command: " << command << std::endl;
-    int res = this->CTest->RunCommand(command.c_str(), &output, &errors,
-                &retVal, fileDir.c_str(), 0 /*this->TimeOut*/);
-
     *cont->OFS << "  Output: " << output << std::endl;
     *cont->OFS << "  Errors: " << errors << std::endl;
-    if ( ! res )
+    if ( ! job->Result )
       {
       cmCTestLog(this->CTest, ERROR_MESSAGE,
-        "Problem running coverage on file: " << *it << std::endl);
+        "Problem running coverage on file: " << job->File << std::endl);
       cmCTestLog(this->CTest, ERROR_MESSAGE,
         "Command produced error: " << errors << std::endl);
       cont->Error ++;
@@ -1592,7 +1840,7 @@ int cmCTestCoverageHandler::HandleLCovCoverage(
     if ( retVal != 0 )
       {
       cmCTestLog(this->CTest, ERROR_MESSAGE, "Coverage command returned: "
-        << retVal << " while processing: " << *it << std::endl);
+        << retVal << " while processing: " << job->File << std::endl);
       cmCTestLog(this->CTest, ERROR_MESSAGE,
         "Command produced error: " << cont->Error << std::endl);
       }
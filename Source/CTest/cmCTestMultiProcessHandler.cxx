@@ -27,12 +27,50 @@
 class TestComparator
 {
 public:
-  TestComparator(cmCTestMultiProcessHandler* handler) : Handler(handler) {}
+  TestComparator(cmCTestMultiProcessHandler* handler) : Handler(handler),
+    CPUTime(handler->CTest->GetScheduleType() == "CPUTime") {}
   ~TestComparator() {}
 
   // Sorts tests in descending order of cost
   bool operator() (int index1, int index2) const
     {
+    return this->GetCost(index1) > this->GetCost(index2);
+    }
+
+private:
+  float GetCost(int index) const
+    {
+    if(this->CPUTime)
+      {
+      std::map<int, float>::const_iterator i =
+        Handler->RecordedCPUCosts.find(index);
+      if(i != Handler->RecordedCPUCosts.end())
+        {
+        return i->second;
+        }
+      }
+    return Handler->Properties[index]->Cost;
+    }
+
+  cmCTestMultiProcessHandler* Handler;
+  bool CPUTime;
+};
+
+class TestCriticalPathComparator
+{
+public:
+  TestCriticalPathComparator(cmCTestMultiProcessHandler* handler)
+    : Handler(handler) {}
+
+  // Sorts tests in descending order of critical path, then cost
+  bool operator() (int index1, int index2) const
+    {
+    double path1 = Handler->CriticalPaths[index1];
+    double path2 = Handler->CriticalPaths[index2];
+    if(path1 != path2)
+      {
+      return path1 > path2;
+      }
     return Handler->Properties[index1]->Cost >
       Handler->Properties[index2]->Cost;
     }
@@ -50,6 +88,7 @@ cmCTestMultiProcessHandler::cmCTestMultiProcessHandler()
   this->StopTimePassed = false;
   this->HasCycles = false;
   this->SerialTestRunning = false;
+  this->NextTestToWaitOn = 0;
 }
 
 cmCTestMultiProcessHandler::~cmCTestMultiProcessHandler()
@@ -70,6 +109,31 @@ cmCTestMultiProcessHandler::SetTests(TestMap& tests,
     {
     this->TestRunningMap[i->first] = false;
     this->TestFinishMap[i->first] = false;
+    // Record for every test the tests that depend on it so that
+    // finishing a test only visits its own dependents.
+    for(TestSet::iterator j = i->second.begin(); j != i->second.end(); ++j)
+      {
+      this->Dependents[*j].insert(i->first);
+      }
+    }
+  // Demands on pools that were not declared are not limited.
+  std::set<std::string> undeclared;
+  for(PropertiesMap::iterator i = this->Properties.begin();
+      i != this->Properties.end(); ++i)
+    {
+    cmCTest::ResourcePoolMap const& demands = i->second->ResourcePoolDemands;
+    for(cmCTest::ResourcePoolMap::const_iterator d = demands.begin();
+        d != demands.end(); ++d)
+      {
+      if(this->ResourcePools.find(d->first) == this->ResourcePools.end() &&
+         undeclared.insert(d->first).second)
+        {
+        cmCTestLog(this->CTest, WARNING, "Resource pool \"" << d->first
+                   << "\" required by test " << i->second->Name
+                   << " is not declared and will not limit tests."
+                   << std::endl);
+        }
+      }
     }
   if(!this->CTest->GetShowOnly())
     {
@@ -79,8 +143,45 @@ cmCTestMultiProcessHandler::SetTests(TestMap& tests,
       {
       return;
       }
+    this->ComputeCriticalPaths();
     this->CreateTestCostList();
+    this->InitializeReadyTests();
+    }
+}
+
+//---------------------------------------------------------
+void cmCTestMultiProcessHandler::InitializeReadyTests()
+{
+  // Tests become ready in the order of the cost list.
+  for(size_t i = 0; i < this->SortedTests.size(); ++i)
+    {
+    int test = this->SortedTests[i];
+    this->TestPriorities[test] = i;
+    if(this->Tests[test].empty())
+      {
+      this->ReadyTests[i] = test;
+      }
+    }
+}
+
+//---------------------------------------------------------
+void cmCTestMultiProcessHandler::ReleaseDependents(int test)
+{
+  TestMap::iterator d = this->Dependents.find(test);
+  if(d == this->Dependents.end())
+    {
+    return;
     }
+  for(TestSet::iterator i = d->second.begin(); i != d->second.end(); ++i)
+    {
+    TestMap::iterator t = this->Tests.find(*i);
+    if(t != this->Tests.end() && t->second.erase(test) &&
+       t->second.empty())
+      {
+      this->ReadyTests[this->TestPriorities[*i]] = *i;
+      }
+    }
+  this->Dependents.erase(d);
 }
 
   // Set the max number of tests that can be run at the same time.
@@ -103,6 +204,16 @@ void cmCTestMultiProcessHandler::RunTests()
     return;
     }
   this->TestHandler->SetMaxIndex(this->FindMaxIndex());
+  bool report = this->CTest->GetScheduleReport();
+  double predicted = 0;
+  std::string criticalPath;
+  double criticalPathCost = 0;
+  if(report)
+    {
+    predicted = this->PredictMakespan();
+    criticalPathCost = this->GetCriticalPath(criticalPath);
+    }
+  double startTime = cmSystemTools::GetTime();
   this->StartNextTests();
   while(!this->Tests.empty())
     {
@@ -119,6 +230,185 @@ void cmCTestMultiProcessHandler::RunTests()
     }
   this->MarkFinished();
   this->UpdateCostData();
+  if(report)
+    {
+    double achieved = cmSystemTools::GetTime() - startTime;
+    char buf[1024];
+    sprintf(buf, "%.2f sec", criticalPathCost);
+    cmCTestLog(this->CTest, HANDLER_OUTPUT, std::endl
+      << "Schedule report:" << std::endl
+      << "  Policy:             "
+      << (this->CTest->GetScheduleType() == "CriticalPath" ?
+          "critical path" :
+          this->CTest->GetScheduleType() == "CPUTime" ?
+          "CPU time" : "cost") << std::endl
+      << "  Parallel level:     " << this->ParallelLevel << std::endl
+      << "  Critical path:      " << buf << std::endl);
+    if(!criticalPath.empty())
+      {
+      cmCTestLog(this->CTest, HANDLER_OUTPUT,
+                 "    " << criticalPath << std::endl);
+      }
+    sprintf(buf, "%.2f sec", predicted);
+    cmCTestLog(this->CTest, HANDLER_OUTPUT,
+               "  Predicted makespan: " << buf << std::endl);
+    sprintf(buf, "%.2f sec", achieved);
+    cmCTestLog(this->CTest, HANDLER_OUTPUT,
+               "  Achieved makespan:  " << buf << std::endl);
+    }
+}
+
+//---------------------------------------------------------
+double cmCTestMultiProcessHandler::GetTestCost(int test)
+{
+  float cost = this->Properties[test]->Cost;
+  if(cost == 0)
+    {
+    std::map<int, float>::const_iterator i = this->RecordedCosts.find(test);
+    if(i != this->RecordedCosts.end())
+      {
+      cost = i->second;
+      }
+    }
+  return cost;
+}
+
+//---------------------------------------------------------
+void cmCTestMultiProcessHandler::ComputeCriticalPaths()
+{
+  // Order the tests so that every test comes after its dependencies.
+  std::map<int, size_t> waiting;
+  TestList order;
+  for(TestMap::const_iterator i = this->Tests.begin();
+      i != this->Tests.end(); ++i)
+    {
+    waiting[i->first] = i->second.size();
+    if(i->second.empty())
+      {
+      order.push_back(i->first);
+      }
+    }
+  for(size_t k = 0; k < order.size(); ++k)
+    {
+    TestSet const& dependents = this->Dependents[order[k]];
+    for(TestSet::const_iterator j = dependents.begin();
+        j != dependents.end(); ++j)
+      {
+      if(--waiting[*j] == 0)
+        {
+        order.push_back(*j);
+        }
+      }
+    }
+
+  // The critical path of a test is its own cost plus the longest
+  // critical path of the tests waiting on it.
+  for(TestList::reverse_iterator k = order.rbegin(); k != order.rend(); ++k)
+    {
+    double longest = 0;
+    TestSet const& dependents = this->Dependents[*k];
+    for(TestSet::const_iterator j = dependents.begin();
+        j != dependents.end(); ++j)
+      {
+      longest = std::max(longest, this->CriticalPaths[*j]);
+      }
+    this->CriticalPaths[*k] = this->GetTestCost(*k) + longest;
+    }
+}
+
+//---------------------------------------------------------
+double cmCTestMultiProcessHandler::GetCriticalPath(std::string& names)
+{
+  // Start from the ready test with the longest path and follow the
+  // dependents that carry it.
+  int test = -1;
+  double cost = 0;
+  for(std::map<size_t, int>::const_iterator i = this->ReadyTests.begin();
+      i != this->ReadyTests.end(); ++i)
+    {
+    if(test == -1 || this->CriticalPaths[i->second] > cost)
+      {
+      test = i->second;
+      cost = this->CriticalPaths[test];
+      }
+    }
+  const char* sep = "";
+  while(test != -1)
+    {
+    names += sep;
+    names += this->GetName(test);
+    sep = " -> ";
+    int next = -1;
+    TestSet const& dependents = this->Dependents[test];
+    for(TestSet::const_iterator j = dependents.begin();
+        j != dependents.end(); ++j)
+      {
+      if(next == -1 || this->CriticalPaths[*j] > this->CriticalPaths[next])
+        {
+        next = *j;
+        }
+      }
+    test = next;
+    }
+  return cost;
+}
+
+//---------------------------------------------------------
+double cmCTestMultiProcessHandler::PredictMakespan()
+{
+  // Simulate the scheduler with the recorded cost of every test as
+  // its duration.  A RUN_SERIAL test occupies all process slots.
+  // Resource pools are honored but RESOURCE_LOCK is not.
+  TestMap depends = this->Tests;
+  std::map<size_t, int> ready = this->ReadyTests;
+  std::multimap<double, int> running;
+  cmCTest::ResourcePoolMap poolsUsed;
+  size_t used = 0;
+  double now = 0;
+  for(;;)
+    {
+    std::map<size_t, int>::iterator next = ready.begin();
+    while(next != ready.end() && used < this->ParallelLevel)
+      {
+      int test = next->second;
+      size_t processors = this->Properties[test]->RunSerial ?
+        this->ParallelLevel : this->GetProcessorsUsed(test);
+      if(processors <= this->ParallelLevel - used &&
+         (!this->Properties[test]->RunSerial || used == 0) &&
+         this->ResourcePoolsAvailable(test, poolsUsed))
+        {
+        used += processors;
+        this->UpdateResourcePoolsUsed(test, poolsUsed, true);
+        running.insert(std::make_pair(now + this->GetTestCost(test), test));
+        ready.erase(next++);
+        }
+      else
+        {
+        ++next;
+        }
+      }
+    if(running.empty())
+      {
+      return now;
+      }
+    std::multimap<double, int>::iterator first = running.begin();
+    now = first->first;
+    int test = first->second;
+    running.erase(first);
+    used -= this->Properties[test]->RunSerial ?
+      this->ParallelLevel : this->GetProcessorsUsed(test);
+    this->UpdateResourcePoolsUsed(test, poolsUsed, false);
+    TestSet const& dependents = this->Dependents[test];
+    for(TestSet::const_iterator j = dependents.begin();
+        j != dependents.end(); ++j)
+      {
+      TestMap::iterator t = depends.find(*j);
+      if(t != depends.end() && t->second.erase(test) && t->second.empty())
+        {
+        ready[this->TestPriorities[*j]] = *j;
+        }
+      }
+    }
 }
 
 //---------------------------------------------------------
@@ -159,12 +449,7 @@ void cmCTestMultiProcessHandler::StartTestProcess(int test)
   else
     {
 
-    for(TestMap::iterator j = this->Tests.begin();
-      j != this->Tests.end(); ++j)
-      {
-      j->second.erase(test);
-      }
-
+    this->ReleaseDependents(test);
     this->UnlockResources(test);
     this->Completed++;
     this->TestFinishMap[test] = true;
@@ -184,12 +469,68 @@ void cmCTestMultiProcessHandler::LockResources(int index)
       this->Properties[index]->LockedResources.begin(),
       this->Properties[index]->LockedResources.end());
 
+  this->UpdateResourcePoolsUsed(index, this->ResourcePoolsUsed, true);
+
   if (this->Properties[index]->RunSerial)
     {
     this->SerialTestRunning = true;
     }
 }
 
+//---------------------------------------------------------
+bool cmCTestMultiProcessHandler::ResourcePoolsAvailable(
+  int index, cmCTest::ResourcePoolMap const& used)
+{
+  cmCTest::ResourcePoolMap const& demands =
+    this->Properties[index]->ResourcePoolDemands;
+  for(cmCTest::ResourcePoolMap::const_iterator d = demands.begin();
+      d != demands.end(); ++d)
+    {
+    cmCTest::ResourcePoolMap::const_iterator pool =
+      this->ResourcePools.find(d->first);
+    if(pool == this->ResourcePools.end())
+      {
+      continue;
+      }
+    cmCTest::ResourcePoolMap::const_iterator u = used.find(d->first);
+    unsigned long inUse = u == used.end() ? 0 : u->second;
+    // As with PROCESSORS, a demand larger than the whole pool is
+    // satisfied by waiting until the pool is idle.
+    unsigned long demand = std::min(d->second, pool->second);
+    if(inUse + demand > pool->second)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//---------------------------------------------------------
+void cmCTestMultiProcessHandler::UpdateResourcePoolsUsed(
+  int index, cmCTest::ResourcePoolMap& used, bool add)
+{
+  cmCTest::ResourcePoolMap const& demands =
+    this->Properties[index]->ResourcePoolDemands;
+  for(cmCTest::ResourcePoolMap::const_iterator d = demands.begin();
+      d != demands.end(); ++d)
+    {
+    cmCTest::ResourcePoolMap::const_iterator pool =
+      this->ResourcePools.find(d->first);
+    if(pool != this->ResourcePools.end())
+      {
+      unsigned long demand = std::min(d->second, pool->second);
+      if(add)
+        {
+        used[d->first] += demand;
+        }
+      else
+        {
+        used[d->first] -= demand;
+        }
+      }
+    }
+}
+
 //---------------------------------------------------------
 void cmCTestMultiProcessHandler::UnlockResources(int index)
 {
@@ -199,6 +540,7 @@ void cmCTestMultiProcessHandler::UnlockResources(int index)
     {
     this->LockedResources.erase(*i);
     }
+  this->UpdateResourcePoolsUsed(index, this->ResourcePoolsUsed, false);
   if (this->Properties[index]->RunSerial)
     {
     this->SerialTestRunning = false;
@@ -209,8 +551,11 @@ void cmCTestMultiProcessHandler::UnlockResources(int index)
 void cmCTestMultiProcessHandler::EraseTest(int test)
 {
   this->Tests.erase(test);
-  this->SortedTests.erase(
-    std::find(this->SortedTests.begin(), this->SortedTests.end(), test));
+  std::map<int, size_t>::iterator p = this->TestPriorities.find(test);
+  if(p != this->TestPriorities.end())
+    {
+    this->ReadyTests.erase(p->second);
+    }
 }
 
 //---------------------------------------------------------
@@ -246,6 +591,12 @@ bool cmCTestMultiProcessHandler::StartTest(int test)
       }
     }
 
+  // Check for room in the resource pools
+  if(!this->ResourcePoolsAvailable(test, this->ResourcePoolsUsed))
+    {
+    return false;
+    }
+
   // if there are no depends left then run this test
   if(this->Tests[test].empty())
     {
@@ -278,6 +629,12 @@ void cmCTestMultiProcessHandler::StartNextTests()
     return;
     }
 
+  // Nothing to do until a running test finishes and releases others.
+  if (this->ReadyTests.empty())
+    {
+    return;
+    }
+
   bool allTestsFailedTestLoadCheck = false;
   bool usedFakeLoadForTesting = false;
   size_t minProcessorsRequired = this->ParallelLevel;
@@ -318,28 +675,33 @@ void cmCTestMultiProcessHandler::StartNextTests()
       }
     }
 
-  TestList copy = this->SortedTests;
-  for(TestList::iterator test = copy.begin(); test != copy.end(); ++test)
+  // Only tests whose dependencies have all finished are candidates.
+  // Advance before starting a test because that removes it from the
+  // ready queue.
+  std::map<size_t, int>::iterator next = this->ReadyTests.begin();
+  while(next != this->ReadyTests.end())
     {
+    int test = next->second;
+    ++next;
     // Take a nap if we're currently performing a RUN_SERIAL test.
     if (this->SerialTestRunning)
       {
       break;
       }
     // We can only start a RUN_SERIAL test if no other tests are also running.
-    if (this->Properties[*test]->RunSerial && this->RunningCount > 0)
+    if (this->Properties[test]->RunSerial && this->RunningCount > 0)
       {
       continue;
       }
 
-    size_t processors = GetProcessorsUsed(*test);
+    size_t processors = GetProcessorsUsed(test);
     bool testLoadOk = true;
     if (this->TestLoad > 0)
       {
       if (processors <= spareLoad)
         {
         cmCTestLog(this->CTest, DEBUG,
-                    "OK to run " << GetName(*test) <<
+                    "OK to run " << GetName(test) <<
                     ", it requires " << processors <<
                     " procs & system load is: " <<
                     systemLoad << std::endl);
@@ -354,10 +716,10 @@ void cmCTestMultiProcessHandler::StartNextTests()
     if (processors <= minProcessorsRequired)
       {
       minProcessorsRequired = processors;
-      testWithMinProcessors = GetName(*test);
+      testWithMinProcessors = GetName(test);
       }
 
-    if(testLoadOk && processors <= numToStart && this->StartTest(*test))
+    if(testLoadOk && processors <= numToStart && this->StartTest(test))
       {
       if(this->StopTimePassed)
         {
@@ -413,16 +775,30 @@ bool cmCTestMultiProcessHandler::CheckOutput()
     {
     return false;
     }
+  // Collect available output from every running test without blocking
+  // so that a test that finished is noticed no matter how many tests
+  // are running.  If none finished, block on one running test for a
+  // short time, rotating through them, instead of spinning.
   std::vector<cmCTestRunTest*> finished;
-  std::string out, err;
+  cmCTestRunTest* waitOn = 0;
+  size_t waitIndex = this->NextTestToWaitOn++ % this->RunningTests.size();
   for(std::set<cmCTestRunTest*>::const_iterator i = this->RunningTests.begin();
-      i != this->RunningTests.end(); ++i)
+      i != this->RunningTests.end(); ++i, --waitIndex)
     {
     cmCTestRunTest* p = *i;
-    if(!p->CheckOutput())
+    if(!p->CheckOutput(0))
       {
       finished.push_back(p);
       }
+    else if(waitIndex == 0)
+      {
+      waitOn = p;
+      }
+    }
+  double waitTime = this->RunningTests.size() > 1 ? 0.02 : 0.1;
+  if(finished.empty() && waitOn && !waitOn->CheckOutput(waitTime))
+    {
+    finished.push_back(waitOn);
     }
   for( std::vector<cmCTestRunTest*>::iterator i = finished.begin();
        i != finished.end(); ++i)
@@ -445,11 +821,7 @@ bool cmCTestMultiProcessHandler::CheckOutput()
       {
       this->Failed->push_back(p->GetTestProperties()->Name);
       }
-    for(TestMap::iterator j = this->Tests.begin();
-        j != this->Tests.end(); ++j)
-      {
-      j->second.erase(test);
-      }
+    this->ReleaseDependents(test);
     this->TestFinishMap[test] = true;
     this->TestRunningMap[test] = false;
     this->RunningTests.erase(p);
@@ -461,6 +833,14 @@ bool cmCTestMultiProcessHandler::CheckOutput()
   return true;
 }
 
+//---------------------------------------------------------
+static void cmCTestWriteCostEntry(std::ostream& fout,
+  cmCTestTestHandler::cmCTestTestProperties const* p)
+{
+  fout << p->Name << " " << p->PreviousRuns << " " << p->Cost << " "
+    << p->PreviousCPURuns << " " << p->CPUCost << "\n";
+}
+
 //---------------------------------------------------------
 void cmCTestMultiProcessHandler::UpdateCostData()
 {
@@ -483,23 +863,31 @@ void cmCTestMultiProcessHandler::UpdateCostData()
       std::vector<cmsys::String> parts =
         cmSystemTools::SplitString(line, ' ');
       //Format: <name> <previous_runs> <avg_cost>
+      //        [<previous_cpu_runs> <avg_cpu_cost>]
       if(parts.size() < 3) break;
 
       std::string name = parts[0];
       int prev = atoi(parts[1].c_str());
       float cost = static_cast<float>(atof(parts[2].c_str()));
+      int cpuPrev = 0;
+      float cpuCost = 0;
+      if(parts.size() >= 5)
+        {
+        cpuPrev = atoi(parts[3].c_str());
+        cpuCost = static_cast<float>(atof(parts[4].c_str()));
+        }
 
       int index = this->SearchByName(name);
       if(index == -1)
         {
         // This test is not in memory. We just rewrite the entry
-        fout << name << " " << prev << " " << cost << "\n";
+        fout << name << " " << prev << " " << cost << " "
+          << cpuPrev << " " << cpuCost << "\n";
         }
       else
         {
         // Update with our new average cost
-        fout << name << " " << this->Properties[index]->PreviousRuns << " "
-          << this->Properties[index]->Cost << "\n";
+        cmCTestWriteCostEntry(fout, this->Properties[index]);
         temp.erase(index);
         }
       }
@@ -510,8 +898,7 @@ void cmCTestMultiProcessHandler::UpdateCostData()
   // Add all tests not previously listed in the file
   for(PropertiesMap::iterator i = temp.begin(); i != temp.end(); ++i)
     {
-    fout << i->second->Name << " " << i->second->PreviousRuns << " "
-      << i->second->Cost << "\n";
+    cmCTestWriteCostEntry(fout, i->second);
     }
 
   // Write list of failed tests
@@ -557,6 +944,19 @@ void cmCTestMultiProcessHandler::ReadCostData()
       if(index == -1) continue;
 
       this->Properties[index]->PreviousRuns = prev;
+      this->RecordedCosts[index] = cost;
+      if(parts.size() >= 5)
+        {
+        int cpuPrev = atoi(parts[3].c_str());
+        float cpuCost = static_cast<float>(atof(parts[4].c_str()));
+        this->Properties[index]->PreviousCPURuns = cpuPrev;
+        this->Properties[index]->CPUCost = cpuCost;
+        // An explicit COST property takes precedence over recorded times
+        if(cpuPrev > 0 && this->Properties[index]->Cost == 0)
+          {
+          this->RecordedCPUCosts[index] = cpuCost;
+          }
+        }
       // When not running in parallel mode, don't use cost data
       if(this->ParallelLevel > 1 &&
          this->Properties[index] &&
@@ -633,6 +1033,19 @@ void cmCTestMultiProcessHandler::CreateParallelTestCostList()
       }
     }
 
+  // Optionally start the tests that gate the longest chain of
+  // dependent tests first.
+  if(this->CTest->GetScheduleType() == "CriticalPath")
+    {
+    TestList sortedCopy;
+    sortedCopy.insert(sortedCopy.end(), topLevel.begin(), topLevel.end());
+    std::stable_sort(sortedCopy.begin(), sortedCopy.end(),
+                     TestCriticalPathComparator(this));
+    this->SortedTests.insert(this->SortedTests.end(),
+                             sortedCopy.begin(), sortedCopy.end());
+    return;
+    }
+
   // In parallel test runs repeatedly move dependencies of the tests on
   // the current dependency level to the next level until no
   // further dependencies exist.
@@ -891,6 +1304,7 @@ void cmCTestMultiProcessHandler::CheckResume()
 void cmCTestMultiProcessHandler::RemoveTest(int index)
 {
   this->EraseTest(index);
+  this->ReleaseDependents(index);
   this->Properties.erase(index);
   this->TestRunningMap[index] = false;
   this->TestFinishMap[index] = true;
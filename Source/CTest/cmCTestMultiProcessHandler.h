@@ -24,6 +24,7 @@
 class cmCTestMultiProcessHandler
 {
   friend class TestComparator;
+  friend class TestCriticalPathComparator;
 public:
   struct TestSet : public std::set<int> {};
   struct TestMap : public std::map<int, TestSet> {};
@@ -38,6 +39,9 @@ public:
   // Set the max number of tests that can be run at the same time.
   void SetParallelLevel(size_t);
   void SetTestLoad(unsigned long load);
+  // Set the capacity of the named resource pools tests draw from
+  void SetResourcePools(cmCTest::ResourcePoolMap const& pools)
+    { this->ResourcePools = pools; }
   virtual void RunTests();
   void PrintTestList();
   void PrintLabels();
@@ -81,6 +85,20 @@ protected:
 
   void CreateParallelTestCostList();
 
+  // Return the recorded cost of a test even when not running in parallel
+  double GetTestCost(int test);
+  // Compute the longest chain of test costs starting at each test
+  void ComputeCriticalPaths();
+  // Return the cost and the names of the tests of the longest chain
+  double GetCriticalPath(std::string& names);
+  // Simulate the schedule with recorded costs as test durations
+  double PredictMakespan();
+
+  // Build the reverse dependency edges and the initial ready queue
+  void InitializeReadyTests();
+  // Remove a finished test from the depends of the tests waiting on it
+  void ReleaseDependents(int test);
+
   // Removes the checkpoint file
   void MarkFinished();
   void EraseTest(int index);
@@ -98,9 +116,27 @@ protected:
 
   void LockResources(int index);
   void UnlockResources(int index);
+  // Return true if the pools have room for the demands of a test
+  bool ResourcePoolsAvailable(int index,
+                              cmCTest::ResourcePoolMap const& used);
+  // Add or remove the demands of a test to the units in use
+  void UpdateResourcePoolsUsed(int index, cmCTest::ResourcePoolMap& used,
+                               bool add);
   // map from test number to set of depend tests
   TestMap Tests;
   TestList SortedTests;
+  // map from test number to set of tests that depend on it
+  TestMap Dependents;
+  // position of each test in the cost list
+  std::map<int, size_t> TestPriorities;
+  // tests with no depends left that have not started, by cost list position
+  std::map<size_t, int> ReadyTests;
+  // cost of each test recorded in the cost data file
+  std::map<int, float> RecordedCosts;
+  // CPU time of each test recorded in the cost data file
+  std::map<int, float> RecordedCPUCosts;
+  // longest chain of test costs starting at each test
+  std::map<int, double> CriticalPaths;
   //Total number of tests we'll be running
   size_t Total;
   //Number of tests that are complete
@@ -116,10 +152,14 @@ protected:
   std::vector<std::string>* Failed;
   std::vector<std::string> LastTestsFailed;
   std::set<std::string> LockedResources;
+  // capacity and units in use of each declared resource pool
+  cmCTest::ResourcePoolMap ResourcePools;
+  cmCTest::ResourcePoolMap ResourcePoolsUsed;
   std::vector<cmCTestTestHandler::cmCTestTestResult>* TestResults;
   size_t ParallelLevel; // max number of process that can be run at once
   unsigned long TestLoad;
   std::set<cmCTestRunTest*> RunningTests;  // current running tests
+  size_t NextTestToWaitOn; // running test CheckOutput blocks on next
   cmCTestTestHandler * TestHandler;
   cmCTest* CTest;
   bool HasCycles;
@@ -30,9 +30,19 @@ cmCTestRunTest::cmCTestRunTest(cmCTestTestHandler* handler)
   this->TestResult.Status = cmCTestTestHandler::NOT_RUN;
   this->TestResult.TestCount = 0;
   this->TestResult.Properties = 0;
+  this->TestResult.HasResourceUsage = false;
+  this->TestResult.CPUTime = 0;
+  this->TestResult.PeakMemory = -1;
+  this->TestResult.BlockInput = 0;
+  this->TestResult.BlockOutput = 0;
   this->ProcessOutput = "";
   this->CompressedOutput = "";
   this->CompressionRatio = 2;
+  this->OutputLimit = 0;
+  this->OutputSize = 0;
+  this->FullOutputRequested = false;
+  this->SpillFile = 0;
+  this->OutputTailSize = 0;
   this->StopTimePassed = false;
   this->NumberOfRunsLeft = 1; // default to 1 run of the test
   this->RunUntilFail = false; // default to run the test once
@@ -41,16 +51,18 @@ cmCTestRunTest::cmCTestRunTest(cmCTestTestHandler* handler)
 
 cmCTestRunTest::~cmCTestRunTest()
 {
+  delete this->SpillFile;
 }
 
 //----------------------------------------------------------------------------
-bool cmCTestRunTest::CheckOutput()
+bool cmCTestRunTest::CheckOutput(double timeout)
 {
-  // Read lines for up to 0.1 seconds of total time.
-  double timeout = 0.1;
-  double timeEnd = cmSystemTools::GetTime() + timeout;
+  // Once a line arrives keep reading lines that are already available,
+  // but for no more than 0.1 seconds so that a test printing without
+  // pause cannot starve the others.
+  double readEnd = cmSystemTools::GetTime() + 0.1;
   std::string line;
-  while((timeout = timeEnd - cmSystemTools::GetTime(), timeout > 0))
+  for(;;)
     {
     int p = this->TestProcess->GetNextOutputLine(line, timeout);
     if(p == cmsysProcess_Pipe_None)
@@ -63,19 +75,21 @@ bool cmCTestRunTest::CheckOutput()
       // Store this line of output.
       cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
                  this->GetIndex() << ": " << line << std::endl);
-      this->ProcessOutput += line;
-      this->ProcessOutput += "\n";
+      this->AddOutputLine(line);
 
-      // Check for TIMEOUT_AFTER_MATCH property.
+      // Check for TIMEOUT_AFTER_MATCH property.  Once output is spilled
+      // only the new line is checked.
       if (!this->TestProperties->TimeoutRegularExpressions.empty())
         {
+        std::string const& output =
+          this->SpillFile ? line : this->ProcessOutput;
         std::vector<std::pair<cmsys::RegularExpression,
           std::string> >::iterator regIt;
         for ( regIt = this->TestProperties->TimeoutRegularExpressions.begin();
               regIt != this->TestProperties->TimeoutRegularExpressions.end();
               ++ regIt )
           {
-          if ( regIt->first.find(this->ProcessOutput.c_str()) )
+          if ( regIt->first.find(output.c_str()) )
             {
             cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
                        this->GetIndex() << ": " <<
@@ -94,61 +108,214 @@ bool cmCTestRunTest::CheckOutput()
       {
       break;
       }
+    if(cmSystemTools::GetTime() > readEnd)
+      {
+      break;
+      }
+    timeout = 0;
     }
   return true;
 }
 
 //---------------------------------------------------------
-// Streamed compression of test output.  The compressed data
-// is appended to this->CompressedOutput
-void cmCTestRunTest::CompressOutput()
+void cmCTestRunTest::AddOutputLine(std::string const& line)
 {
-  int ret;
-  z_stream strm;
+  this->OutputSize += line.size() + 1;
+  if(!this->FullOutputRequested &&
+     line.find("CTEST_FULL_OUTPUT") != line.npos)
+    {
+    this->FullOutputRequested = true;
+    }
 
-  unsigned char* in =
-    reinterpret_cast<unsigned char*>(
-    const_cast<char*>(this->ProcessOutput.c_str()));
-  //zlib makes the guarantee that this is the maximum output size
-  int outSize = static_cast<int>(
-    static_cast<double>(this->ProcessOutput.size()) * 1.001 + 13.0);
-  unsigned char* out = new unsigned char[outSize];
+  if(!this->SpillFile)
+    {
+    this->ProcessOutput += line;
+    this->ProcessOutput += "\n";
+    if(this->OutputLimit && !this->FullOutputRequested &&
+       this->ProcessOutput.size() > this->OutputLimit)
+      {
+      this->StartSpilling();
+      }
+    return;
+    }
 
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = deflateInit(&strm, -1); //default compression level
-  if (ret != Z_OK)
+  *this->SpillFile << line << "\n";
+  this->OutputTail.push_back(line + "\n");
+  this->OutputTailSize += line.size() + 1;
+  while(this->OutputTailSize > this->OutputLimit / 2 &&
+        this->OutputTail.size() > 1)
     {
-    delete[] out;
+    std::string const& evicted = this->OutputTail.front();
+    this->MatchSpilledOutput(evicted);
+    this->OutputTailSize -= evicted.size();
+    this->OutputTail.pop_front();
+    }
+}
+
+//---------------------------------------------------------
+void cmCTestRunTest::StartSpilling()
+{
+  std::ostringstream fname;
+  fname << this->CTest->GetBinaryDir() << "/Testing/Temporary/TestOutput_"
+        << this->Index << ".log";
+  cmsys::ofstream* fout = new cmsys::ofstream(fname.str().c_str());
+  if(!*fout)
+    {
+    // Keep all output in memory.
+    delete fout;
+    this->OutputLimit = 0;
     return;
     }
+  *fout << this->ProcessOutput;
+  this->SpillFile = fout;
+  this->SpillFileName = fname.str();
+
+  this->RequiredRegexSpilledMatch.assign(
+    this->TestProperties->RequiredRegularExpressions.size(), false);
+  this->ErrorRegexSpilledMatch.assign(
+    this->TestProperties->ErrorRegularExpressions.size(), false);
+
+  // Keep whole lines up to half the limit as the head and queue the
+  // rest for the tail.
+  std::string::size_type cut =
+    this->ProcessOutput.rfind('\n', this->OutputLimit / 2);
+  cut = cut == std::string::npos ? 0 : cut + 1;
+  this->MatchSpilledOutput(this->ProcessOutput.substr(0, cut));
+  this->OutputHead = this->ProcessOutput.substr(0, cut);
+  std::string::size_type pos = cut;
+  std::string::size_type end;
+  while((end = this->ProcessOutput.find('\n', pos)) != std::string::npos)
+    {
+    this->OutputTail.push_back(this->ProcessOutput.substr(pos,
+                                                          end + 1 - pos));
+    this->OutputTailSize += end + 1 - pos;
+    pos = end + 1;
+    }
+  std::string().swap(this->ProcessOutput);
+  while(this->OutputTailSize > this->OutputLimit / 2 &&
+        this->OutputTail.size() > 1)
+    {
+    std::string const& evicted = this->OutputTail.front();
+    this->MatchSpilledOutput(evicted);
+    this->OutputTailSize -= evicted.size();
+    this->OutputTail.pop_front();
+    }
+}
 
-  strm.avail_in = static_cast<uInt>(this->ProcessOutput.size());
-  strm.next_in = in;
-  strm.avail_out = outSize;
-  strm.next_out = out;
-  ret = deflate(&strm, Z_FINISH);
+//---------------------------------------------------------
+void cmCTestRunTest::MatchSpilledOutput(std::string const& text)
+{
+  for(size_t i = 0; i < this->RequiredRegexSpilledMatch.size(); ++i)
+    {
+    if(!this->RequiredRegexSpilledMatch[i] &&
+       this->TestProperties->RequiredRegularExpressions[i].first.find(
+         text.c_str()))
+      {
+      this->RequiredRegexSpilledMatch[i] = true;
+      }
+    }
+  for(size_t i = 0; i < this->ErrorRegexSpilledMatch.size(); ++i)
+    {
+    if(!this->ErrorRegexSpilledMatch[i] &&
+       this->TestProperties->ErrorRegularExpressions[i].first.find(
+         text.c_str()))
+      {
+      this->ErrorRegexSpilledMatch[i] = true;
+      }
+    }
+}
 
-  if(ret == Z_STREAM_ERROR || ret != Z_STREAM_END)
+//---------------------------------------------------------
+void cmCTestRunTest::AssembleSpilledOutput(size_t length)
+{
+  if(!this->SpillFile)
     {
-    cmCTestLog(this->CTest, ERROR_MESSAGE, "Error during output "
-      "compression. Sending uncompressed output." << std::endl);
-    delete[] out;
     return;
     }
+  this->SpillFile->flush();
 
-  (void)deflateEnd(&strm);
+  // The test asked for its full output so read it back.
+  if(this->FullOutputRequested)
+    {
+    cmsys::ifstream fin(this->SpillFileName.c_str());
+    std::ostringstream content;
+    content << fin.rdbuf();
+    this->ProcessOutput = content.str();
+    return;
+    }
+
+  std::ostringstream notice;
+  notice << "...\n"
+    "The middle of the test output was removed since the output exceeds "
+    "the threshold of " << length << " bytes.  "
+    "The full " << this->OutputSize << " bytes of output are in\n"
+    "  " << this->SpillFileName << "\n"
+    "...\n";
+  // Leave truncation of the head to CleanTestOutput when the threshold
+  // has no room for a useful tail.
+  if(length < 4 * notice.str().size())
+    {
+    this->ProcessOutput = this->OutputHead;
+    return;
+    }
+  size_t budget = (length - notice.str().size()) / 2;
 
-  unsigned char *encoded_buffer
-    = new unsigned char[static_cast<int>(outSize * 1.5)];
+  std::string::size_type headSize = this->OutputHead.size();
+  if(headSize > budget)
+    {
+    headSize = this->OutputHead.rfind('\n', budget);
+    headSize = headSize == std::string::npos ? 0 : headSize + 1;
+    }
+  std::deque<std::string>::const_iterator tailBegin = this->OutputTail.end();
+  size_t tailSize = 0;
+  while(tailBegin != this->OutputTail.begin() &&
+        tailSize + (tailBegin - 1)->size() <= budget)
+    {
+    --tailBegin;
+    tailSize += tailBegin->size();
+    }
 
-  size_t rlen
-    = cmsysBase64_Encode(out, strm.total_out, encoded_buffer, 1);
+  this->ProcessOutput = this->OutputHead.substr(0, headSize);
+  this->ProcessOutput += notice.str();
+  for(std::deque<std::string>::const_iterator i = tailBegin;
+      i != this->OutputTail.end(); ++i)
+    {
+    this->ProcessOutput += *i;
+    }
+}
 
-  for(size_t i = 0; i < rlen; i++)
+//---------------------------------------------------------
+// Compression of the test output.  Only the output that is kept is
+// compressed, so the memory used does not grow with the size of the
+// whole output.  The base64 encoding of the compressed data is stored
+// in this->CompressedOutput
+void cmCTestRunTest::CompressOutput()
+{
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  if(deflateInit(&strm, -1) != Z_OK) //default compression level
     {
-    this->CompressedOutput += encoded_buffer[i];
+    return;
+    }
+
+  //zlib makes the guarantee that this is the maximum output size
+  size_t outSize = static_cast<size_t>(
+    static_cast<double>(this->ProcessOutput.size()) * 1.001 + 13.0);
+  std::vector<unsigned char> out(outSize);
+  strm.avail_in = static_cast<uInt>(this->ProcessOutput.size());
+  strm.next_in = reinterpret_cast<unsigned char*>(
+    const_cast<char*>(this->ProcessOutput.c_str()));
+  strm.avail_out = static_cast<uInt>(outSize);
+  strm.next_out = &out[0];
+  int ret = deflate(&strm, Z_FINISH);
+  (void)deflateEnd(&strm);
+  if(ret != Z_STREAM_END)
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE, "Error during output "
+      "compression. Sending uncompressed output." << std::endl);
+    return;
     }
 
   if(strm.total_in)
@@ -157,19 +324,31 @@ void cmCTestRunTest::CompressOutput()
                              static_cast<double>(strm.total_in);
     }
 
-  delete [] encoded_buffer;
-  delete [] out;
+  std::vector<unsigned char> encoded(
+    static_cast<size_t>(strm.total_out * 1.5) + 4);
+  size_t rlen = cmsysBase64_Encode(&out[0],
+    static_cast<unsigned long>(strm.total_out), &encoded[0], 1);
+  this->CompressedOutput.assign(reinterpret_cast<char*>(&encoded[0]), rlen);
+}
+
+//---------------------------------------------------------
+static bool cmCTestRunTestSpilledMatch(std::vector<bool> const& matches,
+                                       size_t index)
+{
+  return index < matches.size() && matches[index];
 }
 
 //---------------------------------------------------------
 bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
 {
-  if ((!this->TestHandler->MemCheck &&
-      this->CTest->ShouldCompressTestOutput()) ||
-      (this->TestHandler->MemCheck &&
-      this->CTest->ShouldCompressMemCheckOutput()))
+  if(this->SpillFile)
     {
-    this->CompressOutput();
+    // The retained tail has not been checked yet.
+    for(std::deque<std::string>::const_iterator i = this->OutputTail.begin();
+        i != this->OutputTail.end(); ++i)
+      {
+      this->MatchSpilledOutput(*i);
+      }
     }
 
   this->WriteLogOutputTop(completed, total);
@@ -189,7 +368,10 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
           passIt != this->TestProperties->RequiredRegularExpressions.end();
           ++ passIt )
       {
-      if ( passIt->first.find(this->ProcessOutput.c_str()) )
+      if ( passIt->first.find(this->ProcessOutput.c_str()) ||
+           cmCTestRunTestSpilledMatch(this->RequiredRegexSpilledMatch,
+             passIt -
+             this->TestProperties->RequiredRegularExpressions.begin()) )
         {
         found = true;
         reason = "Required regular expression found.";
@@ -217,7 +399,9 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
           passIt != this->TestProperties->ErrorRegularExpressions.end();
           ++ passIt )
       {
-      if ( passIt->first.find(this->ProcessOutput.c_str()) )
+      if ( passIt->first.find(this->ProcessOutput.c_str()) ||
+           cmCTestRunTestSpilledMatch(this->ErrorRegexSpilledMatch,
+             passIt - this->TestProperties->ErrorRegularExpressions.begin()) )
         {
         reason = "Error regular expression found in output.";
         reason += " Regex=[";
@@ -291,6 +475,16 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
     }
 
   passed = this->TestResult.Status == cmCTestTestHandler::COMPLETED;
+  this->AssembleSpilledOutput(static_cast<size_t>(passed ?
+    this->TestHandler->CustomMaximumPassedTestOutputSize :
+    this->TestHandler->CustomMaximumFailedTestOutputSize));
+  if ((!this->TestHandler->MemCheck &&
+      this->CTest->ShouldCompressTestOutput()) ||
+      (this->TestHandler->MemCheck &&
+      this->CTest->ShouldCompressMemCheckOutput()))
+    {
+    this->CompressOutput();
+    }
   char buf[1024];
   sprintf(buf, "%6.2f sec", this->TestProcess->GetTotalTime());
   cmCTestLog(this->CTest, HANDLER_OUTPUT, buf << "\n" );
@@ -381,6 +575,12 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
     this->TestResult.ReturnValue = this->TestProcess->GetExitValue();
     this->TestResult.CompletionStatus = "Completed";
     this->TestResult.ExecutionTime = this->TestProcess->GetTotalTime();
+    this->TestResult.HasResourceUsage =
+      this->TestProcess->GetHasResourceUsage();
+    this->TestResult.CPUTime = this->TestProcess->GetCPUTime();
+    this->TestResult.PeakMemory = this->TestProcess->GetMaxResidentSize();
+    this->TestResult.BlockInput = this->TestProcess->GetBlockInput();
+    this->TestResult.BlockOutput = this->TestProcess->GetBlockOutput();
     this->MemCheckPostProcess();
     this->ComputeWeightedCost();
     }
@@ -389,6 +589,9 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
   if(!this->NeedsToRerun())
     {
     this->TestHandler->TestResults.push_back(this->TestResult);
+    this->TestHandler->StreamTestResult(this->TestResult,
+      this->TestResult.CompressOutput ? this->ProcessOutput
+      : this->TestResult.Output, this->SpillFileName);
     }
   delete this->TestProcess;
   return passed;
@@ -440,6 +643,15 @@ void cmCTestRunTest::ComputeWeightedCost()
     this->TestProperties->Cost =
       static_cast<float>(((prev * avgcost) + current) / (prev + 1.0));
     this->TestProperties->PreviousRuns++;
+    if(this->TestResult.HasResourceUsage)
+      {
+      double cpuprev =
+        static_cast<double>(this->TestProperties->PreviousCPURuns);
+      double cpucost = static_cast<double>(this->TestProperties->CPUCost);
+      this->TestProperties->CPUCost = static_cast<float>(
+        ((cpuprev * cpucost) + this->TestResult.CPUTime) / (cpuprev + 1.0));
+      this->TestProperties->PreviousCPURuns++;
+      }
     }
 }
 
@@ -474,6 +686,7 @@ bool cmCTestRunTest::StartTest(size_t total)
   std::vector<std::string>& args = this->TestProperties->Args;
   this->TestResult.Properties = this->TestProperties;
   this->TestResult.ExecutionTime = 0;
+  this->TestResult.HasResourceUsage = false;
   this->TestResult.CompressOutput = false;
   this->TestResult.ReturnValue = -1;
   this->TestResult.CompletionStatus = "Failed to start";
@@ -482,6 +695,22 @@ bool cmCTestRunTest::StartTest(size_t total)
   this->TestResult.Name = this->TestProperties->Name;
   this->TestResult.Path = this->TestProperties->Directory.c_str();
 
+  // Drop the output captured by a previous run of this test.
+  this->ProcessOutput = "";
+  this->CompressedOutput = "";
+  this->CompressionRatio = 2;
+  this->OutputLimit = 0;
+  this->OutputSize = 0;
+  this->FullOutputRequested = false;
+  delete this->SpillFile;
+  this->SpillFile = 0;
+  this->SpillFileName = "";
+  this->OutputHead = "";
+  this->OutputTail.clear();
+  this->OutputTailSize = 0;
+  this->RequiredRegexSpilledMatch.clear();
+  this->ErrorRegexSpilledMatch.clear();
+
   if(args.size() >= 2 && args[1] == "NOT_AVAILABLE")
     {
     this->TestProcess = new cmProcess;
@@ -552,6 +781,18 @@ bool cmCTestRunTest::StartTest(size_t total)
     {
     return false;
     }
+  // Bound the output kept in memory by the largest size that may be
+  // submitted, but keep at least one MiB.  MemCheck parses the whole
+  // output.
+  if(!this->TestHandler->MemCheck &&
+     this->TestHandler->CustomMaximumPassedTestOutputSize > 0 &&
+     this->TestHandler->CustomMaximumFailedTestOutputSize > 0)
+    {
+    this->OutputLimit = std::max(static_cast<size_t>(std::max(
+      this->TestHandler->CustomMaximumPassedTestOutputSize,
+      this->TestHandler->CustomMaximumFailedTestOutputSize)),
+      static_cast<size_t>(1 << 20));
+    }
   return this->ForkProcess(timeout, this->TestProperties->ExplicitTimeout,
                            &this->TestProperties->Environment);
 }
@@ -16,6 +16,10 @@
 
 #include <cmProcess.h>
 
+#include <cmsys/FStream.hxx>
+
+#include <deque>
+
 /** \class cmRunTest
  * \brief represents a single test to be run
  *
@@ -46,8 +50,9 @@ public:
   cmCTestTestHandler::cmCTestTestResult GetTestResults()
   { return this->TestResult; }
 
-  // Read and store output.  Returns true if it must be called again.
-  bool CheckOutput();
+  // Read and store output, waiting up to the given number of seconds
+  // for the first line.  Returns true if it must be called again.
+  bool CheckOutput(double timeout);
 
   // Compresses the output, writing to CompressedOutput
   void CompressOutput();
@@ -65,6 +70,16 @@ public:
 private:
   bool NeedsToRerun();
   void DartProcessing();
+  // Store one line of output.  Once the output exceeds OutputLimit only
+  // its head and tail are kept and the whole output goes to SpillFile.
+  void AddOutputLine(std::string const& line);
+  void StartSpilling();
+  // Check the pass and fail regular expressions against output that
+  // will not be part of the final ProcessOutput
+  void MatchSpilledOutput(std::string const& text);
+  // Rebuild ProcessOutput from the head and tail of spilled output
+  // to fit the given length
+  void AssembleSpilledOutput(size_t length);
   void ExeNotFound(std::string exe);
   // Figures out a final timeout which is min(STOP_TIME, NOW+TIMEOUT)
   double ResolveTimeout();
@@ -90,6 +105,17 @@ private:
   std::string ProcessOutput;
   std::string CompressedOutput;
   double CompressionRatio;
+  // Bounded capture of large output
+  size_t OutputLimit;
+  size_t OutputSize;
+  bool FullOutputRequested;
+  std::string SpillFileName;
+  cmsys::ofstream* SpillFile;
+  std::string OutputHead;
+  std::deque<std::string> OutputTail;
+  size_t OutputTailSize;
+  std::vector<bool> RequiredRegexSpilledMatch;
+  std::vector<bool> ErrorRegexSpilledMatch;
   //The test results
   cmCTestTestHandler::cmCTestTestResult TestResult;
   int Index;
@@ -27,6 +27,7 @@ cmCTestTestCommand::cmCTestTestCommand()
   this->Arguments[ctt_SCHEDULE_RANDOM] = "SCHEDULE_RANDOM";
   this->Arguments[ctt_STOP_TIME] = "STOP_TIME";
   this->Arguments[ctt_TEST_LOAD] = "TEST_LOAD";
+  this->Arguments[ctt_SHARD] = "SHARD";
   this->Arguments[ctt_LAST] = 0;
   this->Last = ctt_LAST;
 }
@@ -104,6 +105,10 @@ cmCTestGenericHandler* cmCTestTestCommand::InitializeHandler()
     {
     this->CTest->SetStopTime(this->Values[ctt_STOP_TIME]);
     }
+  if(this->Values[ctt_SHARD])
+    {
+    handler->SetOption("Shard", this->Values[ctt_SHARD]);
+    }
 
   // Test load is determined by: TEST_LOAD argument,
   // or CTEST_TEST_LOAD script variable, or ctest --test-load
@@ -136,6 +141,15 @@ cmCTestGenericHandler* cmCTestTestCommand::InitializeHandler()
     }
   handler->SetTestLoad(testLoad);
 
+  // Resource pools may be declared by the CTEST_RESOURCE_POOLS script
+  // variable in place of the ResourcePools configuration setting.
+  const char* ctestResourcePools
+    = this->Makefile->GetDefinition("CTEST_RESOURCE_POOLS");
+  if(ctestResourcePools && *ctestResourcePools)
+    {
+    this->CTest->SetResourcePools(ctestResourcePools);
+    }
+
   handler->SetQuiet(this->Quiet);
   return handler;
 }
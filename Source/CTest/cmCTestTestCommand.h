@@ -61,6 +61,7 @@ protected:
     ctt_SCHEDULE_RANDOM,
     ctt_STOP_TIME,
     ctt_TEST_LOAD,
+    ctt_SHARD,
     ctt_LAST
   };
 };
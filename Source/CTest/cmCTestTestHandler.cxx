@@ -22,6 +22,9 @@
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
 #include "cmXMLWriter.h"
+#include "cm_jsoncpp_reader.h"
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
 #include "cm_utf8.h"
 #include "cmake.h"
 #include <cmsys/Base64.h>
@@ -391,6 +394,11 @@ cmCTestTestHandler::cmCTestTestHandler()
   this->MemCheck = false;
 
   this->LogFile = 0;
+  this->JSONLinesFile = 0;
+  this->JUnitCasesFile = 0;
+  this->ExplainSelection = false;
+  this->ShardIndex = 0;
+  this->ShardCount = 0;
 
   // regex to detect <DartMeasurement>...</DartMeasurement>
   this->DartStuff.compile(
@@ -520,6 +528,20 @@ int cmCTestTestHandler::ProcessHandler()
     this->SetExcludeRegExp(val);
     }
   this->SetRerunFailed(cmSystemTools::IsOn(this->GetOption("RerunFailed")));
+  val = this->GetOption("ChangedFiles");
+  this->ChangedFiles = val ? val : "";
+  this->ExplainSelection =
+    cmSystemTools::IsOn(this->GetOption("ExplainSelection"));
+  this->ShardIndex = 0;
+  this->ShardCount = 0;
+  val = this->GetOption("Shard");
+  if(val && !this->SetShard(val))
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE, "Invalid shard \"" << val
+      << "\".  Expected <index>/<count> with 1 <= index <= count."
+      << std::endl);
+    return -1;
+    }
 
   this->TestResults.clear();
 
@@ -544,10 +566,61 @@ int cmCTestTestHandler::ProcessHandler()
   double clock_start, clock_finish;
   clock_start = cmSystemTools::GetTime();
 
+  // Stream each test result as soon as it completes.
+  cmsys::ofstream jsonLinesFile;
+  const char* jsonLines = this->GetOption("OutputJSONLines");
+  if(jsonLines && *jsonLines)
+    {
+    jsonLinesFile.open(jsonLines);
+    if(!jsonLinesFile)
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE,
+        "Cannot create JSON lines file: " << jsonLines << std::endl);
+      this->LogFile = 0;
+      return -1;
+      }
+    this->JSONLinesFile = &jsonLinesFile;
+    }
+  cmsys::ofstream junitCasesFile;
+  std::string junitCasesName;
+  const char* junit = this->GetOption("OutputJUnit");
+  if(junit && *junit)
+    {
+    junitCasesName = std::string(junit) + ".cases";
+    junitCasesFile.open(junitCasesName.c_str());
+    if(!junitCasesFile)
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE,
+        "Cannot create JUnit file: " << junitCasesName << std::endl);
+      this->JSONLinesFile = 0;
+      this->LogFile = 0;
+      return -1;
+      }
+    this->JUnitCasesFile = &junitCasesFile;
+    }
+
   this->ProcessDirectory(passed, failed);
 
   clock_finish = cmSystemTools::GetTime();
 
+  this->JSONLinesFile = 0;
+  this->JUnitCasesFile = 0;
+  jsonLinesFile.close();
+  if(!junitCasesName.empty())
+    {
+    junitCasesFile.close();
+    bool written = this->WriteJUnit(junit, junitCasesName,
+                                    clock_finish - clock_start);
+    cmSystemTools::RemoveFile(junitCasesName);
+    if(!written)
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE,
+        "Cannot create JUnit file: " << junit << std::endl);
+      this->LogFile = 0;
+      return -1;
+      }
+    }
+
   total = int(passed.size()) + int(failed.size());
 
   if (total == 0)
@@ -592,6 +665,11 @@ int cmCTestTestHandler::ProcessHandler()
     cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT,
       "\nTotal Test time (real) = " << realBuf << "\n", this->Quiet );
 
+    if (!this->CTest->GetShowOnly())
+      {
+      this->WriteResourceUsage();
+      }
+
     if (!failed.empty())
       {
       cmGeneratedFileStream ofs;
@@ -739,6 +817,52 @@ void cmCTestTestHandler::PrintLabelSummary()
 
 }
 
+//----------------------------------------------------------------------
+void cmCTestTestHandler::WriteResourceUsage()
+{
+  std::string fname = this->CTest->GetBinaryDir()
+    + "/Testing/Temporary/CTestResourceUsage.json";
+  Json::Value root(Json::objectValue);
+  Json::Value& tests = root["tests"] = Json::arrayValue;
+  for(TestResultsVector::const_iterator it = this->TestResults.begin();
+      it != this->TestResults.end(); ++it)
+    {
+    Json::Value& test = tests.append(Json::objectValue);
+    test["name"] = it->Name;
+    test["status"] = this->GetTestStatus(it->Status);
+    test["wallTime"] = it->ExecutionTime;
+    if(it->HasResourceUsage)
+      {
+      test["cpuTime"] = it->CPUTime;
+      if(it->PeakMemory >= 0)
+        {
+        test["peakMemoryKiB"] = static_cast<Json::Int64>(it->PeakMemory);
+        }
+      else
+        {
+        test["peakMemoryKiB"] = Json::nullValue;
+        }
+      test["blockInput"] = static_cast<Json::Int64>(it->BlockInput);
+      test["blockOutput"] = static_cast<Json::Int64>(it->BlockOutput);
+      }
+    else
+      {
+      test["cpuTime"] = Json::nullValue;
+      test["peakMemoryKiB"] = Json::nullValue;
+      test["blockInput"] = Json::nullValue;
+      test["blockOutput"] = Json::nullValue;
+      }
+    }
+  cmGeneratedFileStream fout(fname.c_str());
+  if(!fout)
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE,
+               "Cannot create resource usage file: " << fname << std::endl);
+    return;
+    }
+  fout << root;
+}
+
 //----------------------------------------------------------------------
 void cmCTestTestHandler::CheckLabelFilterInclude(cmCTestTestProperties& it)
 {
@@ -882,6 +1006,14 @@ void cmCTestTestHandler::ComputeTestList()
     it->Index = cnt;  // save the index into the test list for this test
     finalList.push_back(*it);
     }
+  if(!this->ChangedFiles.empty())
+    {
+    this->SelectChangedTests(finalList);
+    }
+  if(this->ShardCount)
+    {
+    this->ShardTestList(finalList);
+    }
   // Save the total number of tests before exclusions
   this->TotalNumberOfTests = this->TestList.size();
   // Set the TestList to the final list of all test
@@ -890,6 +1022,443 @@ void cmCTestTestHandler::ComputeTestList()
   this->UpdateMaxTestNameWidth();
 }
 
+//----------------------------------------------------------------------
+struct cmCTestTestHandlerImpactTarget
+{
+  cmCTestTestHandlerImpactTarget(): Visited(false) {}
+  std::vector<std::string> Depends;
+  std::string Changed;
+  bool Visited;
+  std::string Reason;
+};
+typedef std::map<std::string, cmCTestTestHandlerImpactTarget>
+  cmCTestTestHandlerImpactMap;
+
+//----------------------------------------------------------------------
+// Return why a target is affected by the change set, or an empty
+// string if it is not.
+static std::string const&
+cmCTestTestHandlerImpact(cmCTestTestHandlerImpactMap& targets,
+                         std::string const& name)
+{
+  static std::string const none;
+  cmCTestTestHandlerImpactMap::iterator t = targets.find(name);
+  if(t == targets.end())
+    {
+    return none;
+    }
+  cmCTestTestHandlerImpactTarget& target = t->second;
+  if(target.Visited)
+    {
+    return target.Reason;
+    }
+  target.Visited = true;
+  if(!target.Changed.empty())
+    {
+    target.Reason = name + ": " + target.Changed;
+    return target.Reason;
+    }
+  for(std::vector<std::string>::const_iterator d = target.Depends.begin();
+      d != target.Depends.end(); ++d)
+    {
+    std::string const& reason = cmCTestTestHandlerImpact(targets, *d);
+    if(!reason.empty())
+      {
+      target.Reason = name + " -> " + reason;
+      break;
+      }
+    }
+  return target.Reason;
+}
+
+//----------------------------------------------------------------------
+void cmCTestTestHandler::SelectChangedTests(ListOfTests& tests)
+{
+  // The test impact file is written to the top of the build tree.
+  std::string impactFile;
+  std::string dir = this->CTest->GetBinaryDir();
+  while(!dir.empty())
+    {
+    std::string fname = dir + "/CMakeFiles/TestImpact.json";
+    if(cmSystemTools::FileExists(fname.c_str(), true))
+      {
+      impactFile = fname;
+      break;
+      }
+    std::string parent = cmSystemTools::GetParentDirectory(dir);
+    if(parent == dir)
+      {
+      break;
+      }
+    dir = parent;
+    }
+  Json::Value root;
+  cmsys::ifstream impact(impactFile.c_str());
+  Json::Reader reader;
+  if(impactFile.empty() || !impact || !reader.parse(impact, root, false) ||
+     !root.isObject())
+    {
+    cmCTestLog(this->CTest, WARNING, "Cannot read the test impact file "
+      "CMakeFiles/TestImpact.json written by CMake, running all tests."
+      << std::endl);
+    return;
+    }
+  std::string sourceDir = root["sourceDir"].asString();
+
+  std::set<std::string> changed;
+  std::string buildSystemChange;
+  cmsys::ifstream fin(this->ChangedFiles.c_str());
+  if(!fin)
+    {
+    cmCTestLog(this->CTest, WARNING, "Cannot read the list of changed "
+      "files " << this->ChangedFiles << ", running all tests." << std::endl);
+    return;
+    }
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    line = cmSystemTools::TrimWhitespace(line);
+    if(line.empty())
+      {
+      continue;
+      }
+    cmSystemTools::ConvertToUnixSlashes(line);
+    std::string path = cmSystemTools::CollapseFullPath(line, sourceDir);
+    changed.insert(path);
+    // A change to the build system may affect any test.
+    std::string name = cmSystemTools::GetFilenameName(path);
+    if(buildSystemChange.empty() && (name == "CMakeLists.txt" ||
+       cmSystemTools::GetFilenameLastExtension(name) == ".cmake"))
+      {
+      buildSystemChange = path;
+      }
+    }
+
+  cmCTestTestHandlerImpactMap targets;
+  std::set<std::string> known;
+  Json::Value const& jtargets = root["targets"];
+  for(Json::Value::const_iterator t = jtargets.begin();
+      t != jtargets.end(); ++t)
+    {
+    cmCTestTestHandlerImpactTarget& target = targets[t.key().asString()];
+    Json::Value const& sources = (*t)["sources"];
+    for(Json::Value::const_iterator i = sources.begin();
+        i != sources.end(); ++i)
+      {
+      std::string const source = i->asString();
+      if(changed.find(source) != changed.end())
+        {
+        known.insert(source);
+        if(target.Changed.empty())
+          {
+          target.Changed = source;
+          }
+        }
+      }
+    Json::Value const& depends = (*t)["dependencies"];
+    for(Json::Value::const_iterator i = depends.begin();
+        i != depends.end(); ++i)
+      {
+      target.Depends.push_back(i->asString());
+      }
+    }
+
+  // A changed file that is not a source of any target, such as a header
+  // or test data, may affect any test.
+  std::string unknownChange;
+  for(std::set<std::string>::const_iterator c = changed.begin();
+      c != changed.end() && unknownChange.empty(); ++c)
+    {
+    if(known.find(*c) == known.end())
+      {
+      unknownChange = *c;
+      }
+    }
+
+  // Index the tests by directory and name, and by name alone for
+  // directories whose path is spelled differently.
+  std::map<std::string, Json::Value const*> byPath;
+  std::map<std::string, Json::Value const*> byName;
+  std::set<std::string> ambiguous;
+  Json::Value const& jtests = root["tests"];
+  for(Json::Value::const_iterator t = jtests.begin();
+      t != jtests.end(); ++t)
+    {
+    std::string name = (*t)["name"].asString();
+    byPath[(*t)["directory"].asString() + "/" + name] = &*t;
+    if(!byName.insert(std::make_pair(name, &*t)).second)
+      {
+      ambiguous.insert(name);
+      }
+    }
+
+  ListOfTests selected;
+  std::vector<std::string> reasons;
+  for(ListOfTests::const_iterator it = tests.begin();
+      it != tests.end(); ++it)
+    {
+    std::string reason;
+    Json::Value const* entry = 0;
+    std::map<std::string, Json::Value const*>::const_iterator e =
+      byPath.find(it->Directory + "/" + it->Name);
+    if(e != byPath.end())
+      {
+      entry = e->second;
+      }
+    else if(ambiguous.find(it->Name) == ambiguous.end() &&
+            (e = byName.find(it->Name)) != byName.end())
+      {
+      entry = e->second;
+      }
+    if(!buildSystemChange.empty())
+      {
+      reason = buildSystemChange + " (build system)";
+      }
+    else if(!unknownChange.empty())
+      {
+      reason = unknownChange + " (not a source of any target)";
+      }
+    else if(!entry)
+      {
+      reason = "not in the test impact file";
+      }
+    else
+      {
+      Json::Value const& used = (*entry)["targets"];
+      for(Json::Value::const_iterator u = used.begin();
+          u != used.end() && reason.empty(); ++u)
+        {
+        reason = cmCTestTestHandlerImpact(targets, u->asString());
+        }
+      }
+    if(!reason.empty())
+      {
+      selected.push_back(*it);
+      reasons.push_back(reason);
+      }
+    }
+
+  cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "Selected "
+    << selected.size() << " of " << tests.size() << " tests affected by "
+    << changed.size() << " changed files" << std::endl, this->Quiet);
+  if(this->ExplainSelection)
+    {
+    for(size_t i = 0; i < selected.size(); ++i)
+      {
+      cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "  "
+        << selected[i].Name << ": " << reasons[i] << std::endl,
+        this->Quiet);
+      }
+    }
+  tests = selected;
+}
+
+//----------------------------------------------------------------------
+bool cmCTestTestHandler::SetShard(std::string const& shard)
+{
+  std::string::size_type slash = shard.find('/');
+  unsigned long index;
+  unsigned long count;
+  if(slash == std::string::npos ||
+     !cmSystemTools::StringToULong(shard.substr(0, slash).c_str(), &index) ||
+     !cmSystemTools::StringToULong(shard.substr(slash + 1).c_str(), &count) ||
+     index < 1 || index > count)
+    {
+    return false;
+    }
+  this->ShardIndex = index;
+  this->ShardCount = count;
+  return true;
+}
+
+//----------------------------------------------------------------------
+static size_t cmCTestTestHandlerFindGroup(std::vector<size_t>& parent,
+                                          size_t i)
+{
+  while(parent[i] != i)
+    {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+    }
+  return i;
+}
+
+//----------------------------------------------------------------------
+struct cmCTestTestHandlerShardGroup
+{
+  std::vector<size_t> Tests;
+  double Cost;
+  bool operator<(cmCTestTestHandlerShardGroup const& r) const
+    {
+    // Sort by decreasing cost, then by list position.
+    if(this->Cost != r.Cost)
+      {
+      return this->Cost > r.Cost;
+      }
+    return this->Tests[0] < r.Tests[0];
+    }
+};
+
+//----------------------------------------------------------------------
+void cmCTestTestHandler::ShardTestList(ListOfTests& tests)
+{
+  // Tests connected by DEPENDS or sharing a RESOURCE_LOCK must run in
+  // the same shard.
+  std::vector<size_t> parent(tests.size());
+  std::map<std::string, size_t> byName;
+  for(size_t i = 0; i < tests.size(); ++i)
+    {
+    parent[i] = i;
+    byName[tests[i].Name] = i;
+    }
+  std::map<std::string, size_t> byLock;
+  for(size_t i = 0; i < tests.size(); ++i)
+    {
+    for(std::vector<std::string>::const_iterator d =
+          tests[i].Depends.begin(); d != tests[i].Depends.end(); ++d)
+      {
+      std::map<std::string, size_t>::const_iterator t = byName.find(*d);
+      if(t != byName.end())
+        {
+        parent[cmCTestTestHandlerFindGroup(parent, i)] =
+          cmCTestTestHandlerFindGroup(parent, t->second);
+        }
+      }
+    for(std::set<std::string>::const_iterator l =
+          tests[i].LockedResources.begin();
+        l != tests[i].LockedResources.end(); ++l)
+      {
+      std::map<std::string, size_t>::iterator t = byLock.find(*l);
+      if(t != byLock.end())
+        {
+        parent[cmCTestTestHandlerFindGroup(parent, i)] =
+          cmCTestTestHandlerFindGroup(parent, t->second);
+        }
+      else
+        {
+        byLock[*l] = i;
+        }
+      }
+    }
+
+  // Use the COST property or the average duration recorded by previous
+  // runs.  Tests without either count as the average known test.
+  std::map<std::string, double> recorded;
+  cmsys::ifstream fin(this->CTest->GetCostDataFile().c_str());
+  std::string line;
+  while(fin && std::getline(fin, line) && line != "---")
+    {
+    std::vector<cmsys::String> parts = cmSystemTools::SplitString(line, ' ');
+    if(parts.size() >= 3)
+      {
+      recorded[parts[0]] = atof(parts[2].c_str());
+      }
+    }
+  std::vector<double> costs(tests.size(), -1);
+  double known = 0;
+  size_t numKnown = 0;
+  for(size_t i = 0; i < tests.size(); ++i)
+    {
+    std::map<std::string, double>::const_iterator r =
+      recorded.find(tests[i].Name);
+    if(tests[i].Cost != 0)
+      {
+      costs[i] = tests[i].Cost;
+      }
+    else if(r != recorded.end())
+      {
+      costs[i] = r->second;
+      }
+    if(costs[i] >= 0)
+      {
+      known += costs[i];
+      ++numKnown;
+      }
+    }
+  double unknown = numKnown ? known / static_cast<double>(numKnown) : 1;
+
+  std::map<size_t, size_t> groupOf;
+  std::vector<cmCTestTestHandlerShardGroup> groups;
+  for(size_t i = 0; i < tests.size(); ++i)
+    {
+    size_t root = cmCTestTestHandlerFindGroup(parent, i);
+    std::map<size_t, size_t>::iterator g = groupOf.find(root);
+    if(g == groupOf.end())
+      {
+      g = groupOf.insert(std::make_pair(root, groups.size())).first;
+      groups.push_back(cmCTestTestHandlerShardGroup());
+      groups.back().Cost = 0;
+      }
+    groups[g->second].Tests.push_back(i);
+    groups[g->second].Cost += costs[i] >= 0 ? costs[i] : unknown;
+    }
+
+  // Assign the most expensive groups first, each to the shard with the
+  // least cost so far.  Ties go to the lowest shard so that every
+  // machine computes the same partition from the same inputs.
+  std::sort(groups.begin(), groups.end());
+  std::vector<double> loads(this->ShardCount, 0);
+  std::vector<std::vector<size_t> > shards(this->ShardCount);
+  for(std::vector<cmCTestTestHandlerShardGroup>::const_iterator g =
+        groups.begin(); g != groups.end(); ++g)
+    {
+    size_t best = 0;
+    for(size_t s = 1; s < loads.size(); ++s)
+      {
+      if(loads[s] < loads[best])
+        {
+        best = s;
+        }
+      }
+    loads[best] += g->Cost;
+    shards[best].insert(shards[best].end(), g->Tests.begin(), g->Tests.end());
+    }
+
+  Json::Value root(Json::objectValue);
+  root["shard"] = static_cast<Json::UInt>(this->ShardIndex);
+  root["shardCount"] = static_cast<Json::UInt>(this->ShardCount);
+  Json::Value& manifest = root["shards"] = Json::arrayValue;
+  for(size_t s = 0; s < shards.size(); ++s)
+    {
+    std::sort(shards[s].begin(), shards[s].end());
+    Json::Value& shard = manifest.append(Json::objectValue);
+    shard["index"] = static_cast<Json::UInt>(s + 1);
+    shard["cost"] = loads[s];
+    Json::Value& names = shard["tests"] = Json::arrayValue;
+    for(std::vector<size_t>::const_iterator i = shards[s].begin();
+        i != shards[s].end(); ++i)
+      {
+      names.append(tests[*i].Name);
+      }
+    }
+  std::string fname = this->CTest->GetBinaryDir()
+    + "/Testing/Temporary/CTestShardManifest.json";
+  cmGeneratedFileStream fout(fname.c_str());
+  if(fout)
+    {
+    fout << root;
+    }
+  else
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE,
+               "Cannot create shard manifest: " << fname << std::endl);
+    }
+
+  std::vector<size_t> const& selected = shards[this->ShardIndex - 1];
+  cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "Running shard "
+    << this->ShardIndex << " of " << this->ShardCount << " with "
+    << selected.size() << " of " << tests.size() << " tests" << std::endl,
+    this->Quiet);
+  ListOfTests shardList;
+  for(std::vector<size_t>::const_iterator i = selected.begin();
+      i != selected.end(); ++i)
+    {
+    shardList.push_back(tests[*i]);
+    }
+  tests = shardList;
+}
+
+//----------------------------------------------------------------------
 void cmCTestTestHandler::ComputeTestListForRerunFailed()
 {
   this->ExpandTestsToRunInformationForRerunFailed();
@@ -1083,6 +1652,7 @@ void cmCTestTestHandler::ProcessDirectory(std::vector<std::string> &passed,
     {
     parallel->SetTestLoad(this->CTest->GetTestLoad());
     }
+  parallel->SetResourcePools(this->CTest->GetResourcePools());
 
   *this->LogFile << "Start testing: "
     << this->CTest->CurrentTime() << std::endl
@@ -1163,6 +1733,138 @@ void cmCTestTestHandler::GenerateTestCommand(std::vector<std::string>&, int)
 {
 }
 
+//----------------------------------------------------------------------
+// Return the status of a test result as reported in Test.xml.
+static const char* cmCTestTestHandlerResultStatus(int status)
+{
+  if(status == cmCTestTestHandler::COMPLETED)
+    {
+    return "passed";
+    }
+  else if(status == cmCTestTestHandler::NOT_RUN)
+    {
+    return "notrun";
+    }
+  return "failed";
+}
+
+//----------------------------------------------------------------------
+void cmCTestTestHandler::StreamTestResult(cmCTestTestResult const& result,
+                                          std::string const& output,
+                                          std::string const& outputFile)
+{
+  const char* status = cmCTestTestHandlerResultStatus(result.Status);
+  if(this->JSONLinesFile)
+    {
+    Json::Value test(Json::objectValue);
+    test["name"] = result.Name;
+    test["index"] = result.TestCount;
+    test["status"] = status;
+    test["details"] = this->GetTestStatus(result.Status);
+    test["returnValue"] = result.ReturnValue;
+    test["duration"] = result.ExecutionTime;
+    Json::Value& labels = test["labels"] = Json::arrayValue;
+    if(result.Properties)
+      {
+      for(std::vector<std::string>::const_iterator l =
+            result.Properties->Labels.begin();
+          l != result.Properties->Labels.end(); ++l)
+        {
+        labels.append(*l);
+        }
+      }
+    if(!outputFile.empty())
+      {
+      test["outputFile"] = outputFile;
+      }
+    else
+      {
+      test["outputFile"] = Json::nullValue;
+      }
+    test["output"] = output;
+    Json::FastWriter writer;
+    *this->JSONLinesFile << writer.write(test) << std::flush;
+    }
+  if(this->JUnitCasesFile)
+    {
+    cmXMLWriter xml(*this->JUnitCasesFile, 1);
+    xml.StartElement("testcase");
+    xml.Attribute("name", result.Name);
+    xml.Attribute("classname", result.Name);
+    xml.Attribute("time", result.ExecutionTime);
+    if(result.Status == cmCTestTestHandler::NOT_RUN)
+      {
+      xml.StartElement("skipped");
+      xml.Attribute("message", result.CompletionStatus);
+      xml.EndElement(); // skipped
+      }
+    else if(result.Status != cmCTestTestHandler::COMPLETED)
+      {
+      xml.StartElement("failure");
+      xml.Attribute("message", this->GetTestStatus(result.Status));
+      xml.EndElement(); // failure
+      }
+    xml.Element("system-out", output);
+    xml.EndElement(); // testcase
+    *this->JUnitCasesFile << std::flush;
+    }
+}
+
+//----------------------------------------------------------------------
+bool cmCTestTestHandler::WriteJUnit(std::string const& fname,
+                                    std::string const& casesName,
+                                    double elapsed)
+{
+  size_t failures = 0;
+  size_t skipped = 0;
+  for(TestResultsVector::const_iterator it = this->TestResults.begin();
+      it != this->TestResults.end(); ++it)
+    {
+    if(it->Status == cmCTestTestHandler::NOT_RUN)
+      {
+      ++skipped;
+      }
+    else if(it->Status != cmCTestTestHandler::COMPLETED)
+      {
+      ++failures;
+      }
+    }
+  std::string name = this->CTest->GetCTestConfiguration("BuildName");
+  if(name.empty())
+    {
+    name = "ctest";
+    }
+
+  cmGeneratedFileStream fout(fname.c_str());
+  if(!fout)
+    {
+    return false;
+    }
+  cmXMLWriter xml(fout);
+  xml.StartDocument();
+  xml.StartElement("testsuite");
+  xml.Attribute("name", name);
+  xml.Attribute("tests", this->TestResults.size());
+  xml.Attribute("failures", failures);
+  xml.Attribute("skipped", skipped);
+  xml.Attribute("time", elapsed);
+  xml.FragmentFile(casesName.c_str());
+  xml.EndElement(); // testsuite
+  xml.EndDocument();
+  return fout.Close();
+}
+
+//----------------------------------------------------------------------
+static void cmCTestTestHandlerWriteUsage(cmXMLWriter& xml, const char* name,
+                                         long value)
+{
+  xml.StartElement("NamedMeasurement");
+  xml.Attribute("type", "numeric/integer");
+  xml.Attribute("name", name);
+  xml.Element("Value", value);
+  xml.EndElement(); // NamedMeasurement
+}
+
 //----------------------------------------------------------------------
 void cmCTestTestHandler::GenerateDartOutput(cmXMLWriter& xml)
 {
@@ -1211,6 +1913,23 @@ void cmCTestTestHandler::GenerateDartOutput(cmXMLWriter& xml)
       xml.Attribute("name", "Execution Time");
       xml.Element("Value", result->ExecutionTime);
       xml.EndElement(); // NamedMeasurement
+      if(result->HasResourceUsage)
+        {
+        xml.StartElement("NamedMeasurement");
+        xml.Attribute("type", "numeric/double");
+        xml.Attribute("name", "CPU Time");
+        xml.Element("Value", result->CPUTime);
+        xml.EndElement(); // NamedMeasurement
+        if(result->PeakMemory >= 0)
+          {
+          cmCTestTestHandlerWriteUsage(xml, "Peak Memory (KiB)",
+                                       result->PeakMemory);
+          }
+        cmCTestTestHandlerWriteUsage(xml, "Block Input",
+                                     result->BlockInput);
+        cmCTestTestHandlerWriteUsage(xml, "Block Output",
+                                     result->BlockOutput);
+        }
       if(!result->Reason.empty())
         {
         const char* reasonType = "Pass Reason";
@@ -1276,18 +1995,7 @@ void cmCTestTestHandler::WriteTestResultHeader(cmXMLWriter& xml,
                                                cmCTestTestResult* result)
 {
   xml.StartElement("Test");
-  if ( result->Status == cmCTestTestHandler::COMPLETED )
-    {
-    xml.Attribute("Status", "passed");
-    }
-  else if ( result->Status == cmCTestTestHandler::NOT_RUN )
-    {
-    xml.Attribute("Status", "notrun");
-    }
-  else
-    {
-    xml.Attribute("Status", "failed");
-    }
+  xml.Attribute("Status", cmCTestTestHandlerResultStatus(result->Status));
   std::string testPath = result->Path + "/" + result->Name;
   xml.Element("Name", result->Name);
   xml.Element("Path", this->CTest->GetShortPathToFile(result->Path.c_str()));
@@ -2166,6 +2874,15 @@ bool cmCTestTestHandler::SetTestsProperties(
 
             rtit->LockedResources.insert(lval.begin(), lval.end());
             }
+          if ( key == "RESOURCE_POOLS" )
+            {
+            if(!cmCTest::ParseResourcePools(val, rtit->ResourcePoolDemands))
+              {
+              cmCTestLog(this->CTest, WARNING,
+                "Invalid value for RESOURCE_POOLS of test "
+                << rtit->Name << " : " << val << std::endl);
+              }
+            }
           if ( key == "TIMEOUT" )
             {
             rtit->Timeout = atof(val.c_str());
@@ -2357,6 +3074,8 @@ bool cmCTestTestHandler::AddTest(const std::vector<std::string>& args)
   test.Processors = 1;
   test.SkipReturnCode = -1;
   test.PreviousRuns = 0;
+  test.CPUCost = 0;
+  test.PreviousCPURuns = 0;
   if (this->UseIncludeRegExpFlag &&
     !this->IncludeTestsRegularExpression.find(testname.c_str()))
     {
@@ -111,6 +111,9 @@ public:
     bool WillFail;
     float Cost;
     int PreviousRuns;
+    // average CPU time of previous runs that reported resource usage
+    float CPUCost;
+    int PreviousCPURuns;
     bool RunSerial;
     double Timeout;
     bool ExplicitTimeout;
@@ -123,6 +126,8 @@ public:
     std::vector<std::string> Environment;
     std::vector<std::string> Labels;
     std::set<std::string> LockedResources;
+    // units requested from each named resource pool
+    std::map<std::string, unsigned long> ResourcePoolDemands;
   };
 
   struct cmCTestTestResult
@@ -140,6 +145,13 @@ public:
     std::string DartString;
     int         TestCount;
     cmCTestTestProperties* Properties;
+    // resource usage of the test process and its reaped children;
+    // PeakMemory is -1 when it is not known
+    bool        HasResourceUsage;
+    double      CPUTime;
+    long        PeakMemory;
+    long        BlockInput;
+    long        BlockOutput;
   };
 
   struct cmCTestTestResultLess
@@ -216,6 +228,15 @@ private:
   virtual void GenerateDartOutput(cmXMLWriter& xml);
 
   void PrintLabelSummary();
+  // write the resource usage of all tests to a JSON summary file
+  void WriteResourceUsage();
+  // write a completed test to the JSON lines and JUnit streams
+  void StreamTestResult(cmCTestTestResult const& result,
+                        std::string const& output,
+                        std::string const& outputFile);
+  // write the JUnit file around the test cases streamed so far
+  bool WriteJUnit(std::string const& fname, std::string const& casesName,
+                  double elapsed);
   /**
    * Run the tests for a directory and any subdirectories
    */
@@ -234,6 +255,13 @@ private:
   // based on LastTestFailed.log
   void ComputeTestListForRerunFailed();
 
+  // keep only the tests affected by the files listed in ChangedFiles
+  void SelectChangedTests(ListOfTests& tests);
+
+  // keep only the tests of the selected shard and write the manifest
+  void ShardTestList(ListOfTests& tests);
+  bool SetShard(std::string const& shard);
+
   void UpdateMaxTestNameWidth();
 
   bool GetValue(const char* tag,
@@ -292,8 +320,19 @@ private:
   cmsys::RegularExpression DartStuff;
 
   std::ostream* LogFile;
+  // streams receiving each test result as soon as it completes
+  std::ostream* JSONLinesFile;
+  std::ostream* JUnitCasesFile;
 
   bool RerunFailed;
+
+  // file listing changed source files to select affected tests
+  std::string ChangedFiles;
+  bool ExplainSelection;
+
+  // 1-based index of the shard to run and the number of shards, or 0
+  unsigned long ShardIndex;
+  unsigned long ShardCount;
 };
 
 #endif
@@ -14,6 +14,10 @@
 
 #include <cmSystemTools.h>
 
+#if !defined(_WIN32)
+# include <sys/resource.h>
+#endif
+
 cmProcess::cmProcess()
 {
   this->Process = 0;
@@ -22,6 +26,12 @@ cmProcess::cmProcess()
   this->ExitValue = 0;
   this->Id = 0;
   this->StartTime = 0;
+  this->ChildUsageValid = false;
+  this->HasResourceUsage = false;
+  this->CPUTime = 0;
+  this->MaxResidentSize = -1;
+  this->BlockInput = 0;
+  this->BlockOutput = 0;
 }
 
 cmProcess::~cmProcess()
@@ -134,7 +144,9 @@ int cmProcess::GetNextOutputLine(std::string& line, double timeout)
     // Check for more data from the process.
     char* data;
     int length;
+    this->BeginChildUsage();
     int p = cmsysProcess_WaitForData(this->Process, &data, &length, &timeout);
+    this->EndChildUsage();
     if(p == cmsysProcess_Pipe_Timeout)
       {
       return cmsysProcess_Pipe_Timeout;
@@ -157,7 +169,10 @@ int cmProcess::GetNextOutputLine(std::string& line, double timeout)
     }
 
   // No more data.  Wait for process exit.
-  if(!cmsysProcess_WaitForExit(this->Process, &timeout))
+  this->BeginChildUsage();
+  int exited = cmsysProcess_WaitForExit(this->Process, &timeout);
+  this->EndChildUsage();
+  if(!exited)
     {
     return cmsysProcess_Pipe_Timeout;
     }
@@ -177,6 +192,64 @@ int cmProcess::GetNextOutputLine(std::string& line, double timeout)
   return cmsysProcess_Pipe_None;
 }
 
+//----------------------------------------------------------------------------
+bool cmProcess::GetChildUsage(ChildUsage& usage)
+{
+#if !defined(_WIN32)
+  struct rusage ru;
+  if(getrusage(RUSAGE_CHILDREN, &ru) != 0)
+    {
+    return false;
+    }
+  usage.CPUTime =
+    static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+    static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+# if defined(__APPLE__)
+  // Darwin reports bytes instead of KiB.
+  usage.MaxResidentSize = static_cast<long>(ru.ru_maxrss / 1024);
+# else
+  usage.MaxResidentSize = static_cast<long>(ru.ru_maxrss);
+# endif
+  usage.BlockInput = static_cast<long>(ru.ru_inblock);
+  usage.BlockOutput = static_cast<long>(ru.ru_oublock);
+  return true;
+#else
+  (void)usage;
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// kwsys reaps the children of a process object only within calls made
+// on that object, and ctest makes all of them from one thread.  The
+// usage that the reaped children of ctest gain across such a call
+// therefore belongs to this process.
+void cmProcess::BeginChildUsage()
+{
+  this->ChildUsageValid = GetChildUsage(this->ChildUsageBefore);
+}
+
+//----------------------------------------------------------------------------
+void cmProcess::EndChildUsage()
+{
+  ChildUsage after;
+  if(!this->ChildUsageValid || !GetChildUsage(after))
+    {
+    return;
+    }
+  ChildUsage const& before = this->ChildUsageBefore;
+  this->HasResourceUsage = true;
+  this->CPUTime += after.CPUTime - before.CPUTime;
+  this->BlockInput += after.BlockInput - before.BlockInput;
+  this->BlockOutput += after.BlockOutput - before.BlockOutput;
+  // Only the largest peak of all reaped children is reported, so the
+  // peak of this process is known only if it raised that maximum.
+  if(after.MaxResidentSize > before.MaxResidentSize)
+    {
+    this->MaxResidentSize = after.MaxResidentSize;
+    }
+}
+
 // return the process status
 int cmProcess::GetProcessStatus()
 {
@@ -45,6 +45,13 @@ public:
   void SetId(int id) { this->Id = id;}
   int GetExitValue() { return this->ExitValue;}
   double GetTotalTime() { return this->TotalTime;}
+  // Resource usage of the exited process, if the platform reports it.
+  // The peak resident set size is in KiB, or -1 if it is not known.
+  bool GetHasResourceUsage() { return this->HasResourceUsage; }
+  double GetCPUTime() { return this->CPUTime; }
+  long GetMaxResidentSize() { return this->MaxResidentSize; }
+  long GetBlockInput() { return this->BlockInput; }
+  long GetBlockOutput() { return this->BlockOutput; }
   int GetExitException();
   /**
    * Read one line of output but block for no more than timeout.
@@ -76,6 +83,23 @@ private:
   std::vector<const char*> ProcessArgs;
   int Id;
   int ExitValue;
+  struct ChildUsage
+  {
+    double CPUTime;
+    long MaxResidentSize;
+    long BlockInput;
+    long BlockOutput;
+  };
+  static bool GetChildUsage(ChildUsage& usage);
+  void BeginChildUsage();
+  void EndChildUsage();
+  bool ChildUsageValid;
+  ChildUsage ChildUsageBefore;
+  bool HasResourceUsage;
+  double CPUTime;
+  long MaxResidentSize;
+  long BlockInput;
+  long BlockOutput;
 };
 
 #endif
@@ -0,0 +1,241 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmBuildSystemStamp.h"
+
+#include "cmCryptoHash.h"
+#include "cmGeneratedFileStream.h"
+#include "cmSystemTools.h"
+#include "cmVersion.h"
+
+#include <cmsys/Encoding.hxx>
+#include <cmsys/FStream.hxx>
+
+#include <time.h>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#  include <sys/stat.h>
+#else
+#  include <windows.h>
+#endif
+
+// Bump this when the encoding below changes.
+#define cmBuildSystemStamp_FORMAT 1
+
+static const char cmBuildSystemStampMagic[] = "CMakeBuildSystemStamp";
+
+//----------------------------------------------------------------------------
+// A modification time is stored as the low and high 32 bits of the
+// platform time value followed by the nanoseconds, if known.
+struct cmBuildSystemStampTime
+{
+  unsigned long Low;
+  unsigned long High;
+  unsigned long NSec;
+  bool operator!=(cmBuildSystemStampTime const& r) const
+    {
+    return this->Low != r.Low || this->High != r.High || this->NSec != r.NSec;
+    }
+};
+
+//----------------------------------------------------------------------------
+static bool cmBuildSystemStampGetTime(std::string const& path,
+                                      cmBuildSystemStampTime& t)
+{
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  struct stat st;
+  if(::stat(path.c_str(), &st) != 0)
+    {
+    return false;
+    }
+  // Shift in two steps to avoid a warning on 32-bit time values.
+  t.Low = static_cast<unsigned long>(st.st_mtime) & 0xFFFFFFFF;
+  t.High = static_cast<unsigned long>(st.st_mtime >> 16 >> 16) & 0xFFFFFFFF;
+# if CMake_STAT_HAS_ST_MTIM
+  t.NSec = static_cast<unsigned long>(st.st_mtim.tv_nsec);
+# elif CMake_STAT_HAS_ST_MTIMESPEC
+  t.NSec = static_cast<unsigned long>(st.st_mtimespec.tv_nsec);
+# else
+  t.NSec = 0;
+# endif
+#else
+  WIN32_FILE_ATTRIBUTE_DATA fdata;
+  if(!GetFileAttributesExW(cmsys::Encoding::ToWide(path).c_str(),
+                           GetFileExInfoStandard, &fdata))
+    {
+    return false;
+    }
+  t.Low = fdata.ftLastWriteTime.dwLowDateTime;
+  t.High = fdata.ftLastWriteTime.dwHighDateTime;
+  t.NSec = 0;
+#endif
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// All integers are stored as 32-bit little-endian values and all
+// strings are stored as a length followed by the raw bytes.
+static void cmBuildSystemStampWrite(std::string& out, unsigned long v)
+{
+  char b[4];
+  b[0] = static_cast<char>(v & 0xFF);
+  b[1] = static_cast<char>((v >> 8) & 0xFF);
+  b[2] = static_cast<char>((v >> 16) & 0xFF);
+  b[3] = static_cast<char>((v >> 24) & 0xFF);
+  out.append(b, 4);
+}
+
+//----------------------------------------------------------------------------
+static void cmBuildSystemStampWrite(std::string& out, std::string const& s)
+{
+  cmBuildSystemStampWrite(out, static_cast<unsigned long>(s.size()));
+  out.append(s);
+}
+
+//----------------------------------------------------------------------------
+class cmBuildSystemStampReader
+{
+public:
+  cmBuildSystemStampReader(const char* begin, const char* end):
+    Cur(begin), End(end) {}
+
+  bool Read(unsigned long& v)
+    {
+    if(this->End - this->Cur < 4)
+      {
+      return false;
+      }
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(this->Cur);
+    v = (static_cast<unsigned long>(b[0])) |
+        (static_cast<unsigned long>(b[1]) << 8) |
+        (static_cast<unsigned long>(b[2]) << 16) |
+        (static_cast<unsigned long>(b[3]) << 24);
+    this->Cur += 4;
+    return true;
+    }
+
+  bool Read(std::string& s)
+    {
+    unsigned long n;
+    if(!this->Read(n) || static_cast<unsigned long>(this->End - this->Cur) < n)
+      {
+      return false;
+      }
+    s.assign(this->Cur, n);
+    this->Cur += n;
+    return true;
+    }
+
+  const char* Cur;
+  const char* End;
+};
+
+//----------------------------------------------------------------------------
+bool cmBuildSystemStamp::Write(std::string const& stampFile,
+                               std::vector<std::string> const& files)
+{
+  // A file modified in the same second as it is recorded could be
+  // modified again without changing its time on file systems with a
+  // coarse resolution.  Leave the stamp to a later check.
+  long const recent = static_cast<long>(time(0)) - 1;
+
+  std::string out;
+  cmBuildSystemStampWrite(out, cmBuildSystemStampMagic);
+  cmBuildSystemStampWrite(out, cmBuildSystemStamp_FORMAT);
+  cmBuildSystemStampWrite(out, cmVersion::GetCMakeVersion());
+  cmBuildSystemStampWrite(out, static_cast<unsigned long>(files.size()));
+  for(std::vector<std::string>::const_iterator f = files.begin();
+      f != files.end(); ++f)
+    {
+    std::string const path = cmSystemTools::CollapseFullPath(*f);
+    cmBuildSystemStampTime t;
+    if(!cmBuildSystemStampGetTime(path, t) ||
+       cmSystemTools::ModifiedTime(path) >= recent)
+      {
+      cmSystemTools::RemoveFile(stampFile);
+      return false;
+      }
+    cmBuildSystemStampWrite(out, path);
+    cmBuildSystemStampWrite(out, t.Low);
+    cmBuildSystemStampWrite(out, t.High);
+    cmBuildSystemStampWrite(out, t.NSec);
+    }
+  cmCryptoHashMD5 md5;
+  cmBuildSystemStampWrite(out, md5.HashString(out));
+
+  cmGeneratedFileStream fout;
+  fout.Open(stampFile.c_str(), true, true);
+  if(!fout)
+    {
+    return false;
+    }
+  fout.write(out.c_str(), static_cast<std::streamsize>(out.size()));
+  return fout.Close();
+}
+
+//----------------------------------------------------------------------------
+bool cmBuildSystemStamp::Check(std::string const& stampFile)
+{
+  // Read the whole stamp with a single read.
+  cmsys::ifstream fin(stampFile.c_str(), std::ios::in | std::ios::binary);
+  if(!fin)
+    {
+    return false;
+    }
+  std::string content((std::istreambuf_iterator<char>(fin)),
+                      std::istreambuf_iterator<char>());
+
+  cmBuildSystemStampReader r(content.data(),
+                             content.data() + content.size());
+  std::string magic;
+  std::string version;
+  unsigned long format;
+  unsigned long numFiles;
+  if(!r.Read(magic) || magic != cmBuildSystemStampMagic ||
+     !r.Read(format) || format != cmBuildSystemStamp_FORMAT ||
+     !r.Read(version) || version != cmVersion::GetCMakeVersion() ||
+     !r.Read(numFiles))
+    {
+    return false;
+    }
+  std::vector<std::pair<std::string, cmBuildSystemStampTime> > entries;
+  for(unsigned long i = 0; i < numFiles; ++i)
+    {
+    entries.push_back(std::pair<std::string, cmBuildSystemStampTime>());
+    std::pair<std::string, cmBuildSystemStampTime>& e = entries.back();
+    if(!r.Read(e.first) || !r.Read(e.second.Low) ||
+       !r.Read(e.second.High) || !r.Read(e.second.NSec))
+      {
+      return false;
+      }
+    }
+
+  // Reject a stamp that was truncated or otherwise damaged.
+  std::string const record(content.data(), r.Cur);
+  std::string fingerprint;
+  cmCryptoHashMD5 md5;
+  if(!r.Read(fingerprint) || r.Cur != r.End ||
+     fingerprint != md5.HashString(record))
+    {
+    return false;
+    }
+
+  for(std::vector<std::pair<std::string, cmBuildSystemStampTime> >::
+        const_iterator e = entries.begin(); e != entries.end(); ++e)
+    {
+    cmBuildSystemStampTime t;
+    if(!cmBuildSystemStampGetTime(e->first, t) || t != e->second)
+      {
+      return false;
+      }
+    }
+  return true;
+}
@@ -0,0 +1,44 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmBuildSystemStamp_h
+#define cmBuildSystemStamp_h
+
+#include "cmStandardIncludes.h"
+
+/** \class cmBuildSystemStamp
+ * \brief Record that the build system was found up to date.
+ *
+ * cmBuildSystemStamp stores the full path and modification time of the
+ * inputs and outputs of a build system in a binary file, followed by an
+ * MD5 fingerprint of the whole record.  As long as none of the files
+ * changed, a later check is answered with one stat call per file
+ * instead of reading the build system check file again.
+ */
+class cmBuildSystemStamp
+{
+public:
+  /**
+   * Write the stamp for the given files.  No stamp is written and an
+   * existing one is removed if a file is missing or was modified too
+   * recently for a later modification to be told apart from it.
+   */
+  static bool Write(std::string const& stampFile,
+                    std::vector<std::string> const& files);
+
+  /**
+   * Return whether the stamp exists, is intact and every file it lists
+   * still has the modification time it records.
+   */
+  static bool Check(std::string const& stampFile);
+};
+
+#endif
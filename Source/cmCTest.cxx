@@ -293,6 +293,7 @@ cmCTest::cmCTest()
   this->LabelSummary           = true;
   this->ParallelLevel          = 1;
   this->ParallelLevelSetInCli  = false;
+  this->ResourcePoolsSetInCli  = false;
   this->TestLoad               = 0;
   this->SubmitIndex            = 0;
   this->Failover               = false;
@@ -321,6 +322,7 @@ cmCTest::cmCTest()
   this->CompressXMLFiles       = false;
   this->CTestConfigFile        = "";
   this->ScheduleType           = "";
+  this->ScheduleReport         = false;
   this->StopTime               = "";
   this->NextDayStopTime        = false;
   this->OutputLogFile          = 0;
@@ -398,6 +400,43 @@ void cmCTest::SetTestLoad(unsigned long load)
   this->TestLoad = load;
 }
 
+//----------------------------------------------------------------------------
+bool cmCTest::ParseResourcePools(std::string const& spec,
+                                 ResourcePoolMap& pools)
+{
+  std::string list = spec;
+  cmSystemTools::ReplaceString(list, ",", ";");
+  std::vector<std::string> entries;
+  cmSystemTools::ExpandListArgument(list, entries);
+  for(std::vector<std::string>::const_iterator i = entries.begin();
+      i != entries.end(); ++i)
+    {
+    std::string::size_type pos = i->find('=');
+    unsigned long count;
+    if(pos == 0 || pos == std::string::npos ||
+       !cmSystemTools::StringToULong(i->c_str() + pos + 1, &count))
+      {
+      return false;
+      }
+    pools[i->substr(0, pos)] = count;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool cmCTest::SetResourcePools(std::string const& spec)
+{
+  ResourcePoolMap pools;
+  if(!ParseResourcePools(spec, pools))
+    {
+    cmCTestLog(this, WARNING, "Invalid value for 'Resource Pools' : "
+               << spec << std::endl);
+    return false;
+    }
+  this->ResourcePools = pools;
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool cmCTest::ShouldCompressTestOutput()
 {
@@ -840,6 +879,11 @@ bool cmCTest::UpdateCTestConfiguration()
           << testLoad << std::endl);
       }
     }
+  std::string const& pools = this->GetCTestConfiguration("ResourcePools");
+  if (!pools.empty() && !this->ResourcePoolsSetInCli)
+    {
+    this->SetResourcePools(pools);
+    }
   if ( this->ProduceXML )
     {
     this->CompressXMLFiles = cmSystemTools::IsOn(
@@ -2090,6 +2134,13 @@ bool cmCTest::HandleCommandLineArguments(size_t &i,
       }
     }
 
+  if(this->CheckArgument(arg, "--resource-pools") && i < args.size() - 1)
+    {
+    i++;
+    this->SetResourcePools(args[i]);
+    this->ResourcePoolsSetInCli = true;
+    }
+
   if(this->CheckArgument(arg, "--no-compress-output"))
     {
     this->CompressTestOutput = false;
@@ -2268,6 +2319,44 @@ bool cmCTest::HandleCommandLineArguments(size_t &i,
     this->GetHandler("memcheck")->
       SetPersistentOption("TestsToRunInformation",args[i].c_str());
     }
+  if(this->CheckArgument(arg, "--output-jsonl") && i < args.size() - 1)
+    {
+    i++;
+    this->GetHandler("test")->SetPersistentOption("OutputJSONLines",
+                                                  args[i].c_str());
+    this->GetHandler("memcheck")->
+      SetPersistentOption("OutputJSONLines", args[i].c_str());
+    }
+  if(this->CheckArgument(arg, "--output-junit") && i < args.size() - 1)
+    {
+    i++;
+    this->GetHandler("test")->SetPersistentOption("OutputJUnit",
+                                                  args[i].c_str());
+    this->GetHandler("memcheck")->
+      SetPersistentOption("OutputJUnit", args[i].c_str());
+    }
+  if(this->CheckArgument(arg, "--changed-files") && i < args.size() - 1)
+    {
+    i++;
+    this->GetHandler("test")->SetPersistentOption("ChangedFiles",
+                                                  args[i].c_str());
+    this->GetHandler("memcheck")->
+      SetPersistentOption("ChangedFiles", args[i].c_str());
+    }
+  if(this->CheckArgument(arg, "--explain-selection"))
+    {
+    this->GetHandler("test")->SetPersistentOption("ExplainSelection",
+                                                  "true");
+    this->GetHandler("memcheck")->SetPersistentOption("ExplainSelection",
+                                                      "true");
+    }
+  if(this->CheckArgument(arg, "--shard") && i < args.size() - 1)
+    {
+    i++;
+    this->GetHandler("test")->SetPersistentOption("Shard", args[i].c_str());
+    this->GetHandler("memcheck")->
+      SetPersistentOption("Shard", args[i].c_str());
+    }
   if(this->CheckArgument(arg, "-U", "--union"))
     {
     this->GetHandler("test")->SetPersistentOption("UseUnion", "true");
@@ -2514,6 +2603,21 @@ int cmCTest::Run(std::vector<std::string> &args, std::string* output)
       this->ScheduleType = "Random";
       }
 
+    if(this->CheckArgument(arg, "--schedule-critical-path"))
+      {
+      this->ScheduleType = "CriticalPath";
+      }
+
+    if(this->CheckArgument(arg, "--schedule-cpu-time"))
+      {
+      this->ScheduleType = "CPUTime";
+      }
+
+    if(this->CheckArgument(arg, "--schedule-report"))
+      {
+      this->ScheduleReport = true;
+      }
+
     // pass the argument to all the handlers as well, but i may no longer be
     // set to what it was originally so I'm not sure this is working as
     // intended
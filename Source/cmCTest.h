@@ -165,6 +165,17 @@ public:
   unsigned long GetTestLoad() { return this->TestLoad; }
   void SetTestLoad(unsigned long);
 
+  /**
+   * Capacity of each named resource pool that tests may draw from with
+   * the RESOURCE_POOLS test property.  The specification is a list of
+   * <name>=<capacity> entries.  Returns false if it is malformed.
+   */
+  typedef std::map<std::string, unsigned long> ResourcePoolMap;
+  ResourcePoolMap const& GetResourcePools() { return this->ResourcePools; }
+  bool SetResourcePools(std::string const& spec);
+  static bool ParseResourcePools(std::string const& spec,
+                                 ResourcePoolMap& pools);
+
   /**
    * Check if CTest file exists
    */
@@ -245,6 +256,9 @@ public:
   std::string GetScheduleType() { return this->ScheduleType; }
   void SetScheduleType(std::string type) { this->ScheduleType = type; }
 
+  /** Whether to print the predicted and achieved test schedule */
+  bool GetScheduleReport() { return this->ScheduleReport; }
+
   ///! The max output width
   int GetMaxTestNameWidth() const;
   void SetMaxTestNameWidth(int w) { this->MaxTestNameWidth = w;}
@@ -444,6 +458,7 @@ private:
   bool RepeatUntilFail;
   std::string ConfigType;
   std::string ScheduleType;
+  bool ScheduleReport;
   std::string StopTime;
   bool NextDayStopTime;
   bool Verbose;
@@ -504,6 +519,9 @@ private:
   int                     ParallelLevel;
   bool                    ParallelLevelSetInCli;
 
+  ResourcePoolMap         ResourcePools;
+  bool                    ResourcePoolsSetInCli;
+
   unsigned long           TestLoad;
 
   int                     CompatibilityMode;
@@ -110,6 +110,13 @@ std::string cmCommonTargetGenerator::ComputeFortranModuleDirectory() const
     this->GeneratorTarget->GetProperty("Fortran_MODULE_DIRECTORY");
   const char* moddir_flag =
     this->Makefile->GetDefinition("CMAKE_Fortran_MODDIR_FLAG");
+  if(!target_mod_dir &&
+     this->WorkingDirectory != cmLocalGenerator::START_OUTPUT)
+    {
+    // The compiler does not run in the current output directory, so
+    // tell it to put modules where it would have put them if it did.
+    target_mod_dir = this->LocalGenerator->GetCurrentBinaryDirectory();
+    }
   if(target_mod_dir && moddir_flag)
     {
     // Compute the full path to the module directory.
@@ -231,6 +238,78 @@ cmCommonTargetGenerator
     }
 }
 
+//----------------------------------------------------------------------------
+cmSourceFile*
+cmCommonTargetGenerator::GetPchHeaderSource(const std::string& lang)
+{
+  // A target reusing the precompiled header of another one does not
+  // build its own.
+  if(this->GeneratorTarget->GetPchReuseTarget() != this->GeneratorTarget)
+    {
+    return 0;
+    }
+  std::string const pchHeader =
+    this->GeneratorTarget->GetPchHeader(this->ConfigName, lang);
+  if(pchHeader.empty())
+    {
+    return 0;
+    }
+  cmSourceFile* sf = this->Makefile->GetOrCreateSource(pchHeader, true);
+  sf->SetProperty("LANGUAGE", lang.c_str());
+  // Resolve the full path so the source can be recognized later.
+  sf->GetFullPath();
+  return sf;
+}
+
+//----------------------------------------------------------------------------
+bool cmCommonTargetGenerator::IsPchHeaderSource(cmSourceFile const& source,
+                                                const std::string& lang)
+{
+  return this->GeneratorTarget->GetPchReuseTarget() == this->GeneratorTarget &&
+    source.GetFullPath() ==
+    this->GeneratorTarget->GetPchHeader(this->ConfigName, lang);
+}
+
+//----------------------------------------------------------------------------
+std::string
+cmCommonTargetGenerator::GetPchFileForSource(cmSourceFile const& source,
+                                             const std::string& lang)
+{
+  std::string const pchHeader =
+    this->GeneratorTarget->GetPchHeader(this->ConfigName, lang);
+  if(pchHeader.empty() || this->IsPchHeaderSource(source, lang) ||
+     source.GetPropertyAsBool("SKIP_PRECOMPILE_HEADERS"))
+    {
+    return std::string();
+    }
+  return this->GeneratorTarget->GetPchFile(this->ConfigName, lang);
+}
+
+//----------------------------------------------------------------------------
+void cmCommonTargetGenerator::AppendPchFlags(std::string& flags,
+                                             cmSourceFile const& source,
+                                             const std::string& lang)
+{
+  std::string const pchHeader =
+    this->GeneratorTarget->GetPchHeader(this->ConfigName, lang);
+  if(pchHeader.empty() || source.GetPropertyAsBool("SKIP_PRECOMPILE_HEADERS"))
+    {
+    return;
+    }
+  std::string optionsVar = "CMAKE_" + lang;
+  optionsVar += this->IsPchHeaderSource(source, lang) ?
+    "_COMPILE_OPTIONS_CREATE_PCH" : "_COMPILE_OPTIONS_USE_PCH";
+  std::string options = this->Makefile->GetSafeDefinition(optionsVar);
+  cmSystemTools::ReplaceString(options, "<PCH_HEADER>",
+    this->LocalGenerator->ConvertToOutputFormat(
+      pchHeader, cmLocalGenerator::SHELL).c_str());
+  cmSystemTools::ReplaceString(options, "<PCH_FILE>",
+    this->LocalGenerator->ConvertToOutputFormat(
+      this->GeneratorTarget->GetPchFile(this->ConfigName, lang),
+      cmLocalGenerator::SHELL).c_str());
+  this->LocalGenerator->AppendFlags(flags, options);
+}
+
 //----------------------------------------------------------------------------
 std::string cmCommonTargetGenerator::GetFrameworkFlags(std::string const& l)
 {
@@ -73,6 +73,20 @@ protected:
   void AppendFortranFormatFlags(std::string& flags,
                                 cmSourceFile const& source);
 
+  // The generated precompiled header this target compiles for the
+  // language, if any.  Its object is the precompiled header file.
+  cmSourceFile* GetPchHeaderSource(const std::string& lang);
+  bool IsPchHeaderSource(cmSourceFile const& source, const std::string& lang);
+
+  // The precompiled header file the object of a source needs first,
+  // if any.
+  std::string GetPchFileForSource(cmSourceFile const& source,
+                                  const std::string& lang);
+
+  // Add flags creating or using the precompiled header.
+  void AppendPchFlags(std::string& flags, cmSourceFile const& source,
+                      const std::string& lang);
+
   // Return the a string with -F flags on apple
   std::string GetFrameworkFlags(std::string const& l);
 
@@ -269,6 +269,32 @@ void cmComputeTargetDepends::CollectTargetDepends(int depender_index)
     }
   }
 
+  // A target reusing the precompiled headers of another one needs them
+  // to be built first.
+  if(const char* reuseFrom =
+     depender->GetProperty("PRECOMPILE_HEADERS_REUSE_FROM"))
+    {
+    if(cmGeneratorTarget const* reuseTarget =
+       depender->GetLocalGenerator()->FindGeneratorTargetToUse(reuseFrom))
+      {
+      const_cast<cmGeneratorTarget*>(depender)->Target->AddUtility(reuseFrom);
+      if(!this->CheckPchReuse(depender, reuseTarget))
+        {
+        return;
+        }
+      }
+    else
+      {
+      std::ostringstream e;
+      e << "The PRECOMPILE_HEADERS_REUSE_FROM property of target \""
+        << depender->GetName() << "\" names \"" << reuseFrom
+        << "\" which is not a target.";
+      this->GlobalGenerator->GetCMakeInstance()
+        ->IssueMessage(cmake::FATAL_ERROR, e.str(), depender->GetBacktrace());
+      return;
+      }
+    }
+
   // Loop over all utility dependencies.
   {
   std::set<cmLinkItem> const& tutils = depender->GetUtilityItems();
@@ -287,6 +313,64 @@ void cmComputeTargetDepends::CollectTargetDepends(int depender_index)
   }
 }
 
+//----------------------------------------------------------------------------
+bool
+cmComputeTargetDepends::CheckPchReuse(cmGeneratorTarget const* depender,
+                                      cmGeneratorTarget const* reuseTarget)
+{
+  // A precompiled header can only be used by sources of a language it
+  // was built for and compiled with the same options and definitions.
+  std::vector<std::string> configs;
+  depender->Makefile->GetConfigurations(configs);
+  if (configs.empty())
+    {
+    configs.push_back("");
+    }
+  cmake* cm = this->GlobalGenerator->GetCMakeInstance();
+  for (std::vector<std::string>::const_iterator ci = configs.begin();
+       ci != configs.end(); ++ci)
+    {
+    std::set<std::string> languages;
+    depender->GetLanguages(languages, *ci);
+    for(std::set<std::string>::const_iterator li = languages.begin();
+        li != languages.end(); ++li)
+      {
+      if(!depender->Makefile->GetDefinition(
+           "CMAKE_" + *li + "_COMPILE_OPTIONS_USE_PCH"))
+        {
+        continue;
+        }
+      if(reuseTarget->GetPchHeader(*ci, *li).empty())
+        {
+        std::ostringstream e;
+        e << "The PRECOMPILE_HEADERS_REUSE_FROM property of target \""
+          << depender->GetName() << "\" names \"" << reuseTarget->GetName()
+          << "\" which has no precompiled header for " << *li << ".";
+        cm->IssueMessage(cmake::FATAL_ERROR, e.str(),
+                         depender->GetBacktrace());
+        return false;
+        }
+      std::vector<std::string> dependerFlags;
+      std::vector<std::string> reuseFlags;
+      depender->GetCompileOptions(dependerFlags, *ci, *li);
+      reuseTarget->GetCompileOptions(reuseFlags, *ci, *li);
+      depender->GetCompileDefinitions(dependerFlags, *ci, *li);
+      reuseTarget->GetCompileDefinitions(reuseFlags, *ci, *li);
+      if(dependerFlags != reuseFlags)
+        {
+        std::ostringstream w;
+        w << "The PRECOMPILE_HEADERS_REUSE_FROM property of target \""
+          << depender->GetName() << "\" names \"" << reuseTarget->GetName()
+          << "\" which compiles " << *li << " with different compile "
+          << "options or definitions.  The compiler may not be able to use "
+          << "the precompiled header.";
+        cm->IssueMessage(cmake::WARNING, w.str(), depender->GetBacktrace());
+        }
+      }
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void cmComputeTargetDepends::AddInterfaceDepends(int depender_index,
                                              const cmGeneratorTarget* dependee,
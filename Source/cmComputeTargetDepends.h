@@ -60,6 +60,8 @@ private:
                            cmGeneratorTarget const* dependee,
                            const std::string& config,
                            std::set<std::string> &emitted);
+  bool CheckPchReuse(cmGeneratorTarget const* depender,
+                     cmGeneratorTarget const* reuseTarget);
   cmGlobalGenerator* GlobalGenerator;
   bool DebugMode;
   bool NoCycles;
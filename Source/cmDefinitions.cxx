@@ -18,7 +18,7 @@ cmDefinitions::Def cmDefinitions::NoDef;
 
 //----------------------------------------------------------------------------
 cmDefinitions::Def const& cmDefinitions::GetInternal(
-  const std::string& key, StackIter begin, StackIter end, bool raise)
+  cmInternedString const& key, StackIter begin, StackIter end, bool raise)
 {
   assert(begin != end);
   MapType::iterator i = begin->Map.find(key);
@@ -27,16 +27,26 @@ cmDefinitions::Def const& cmDefinitions::GetInternal(
     i->second.Used = true;
     return i->second;
     }
+  MapType::const_iterator ci = begin->LookupCache.find(key);
+  if (ci != begin->LookupCache.end())
+    {
+    if (!raise)
+      {
+      return ci->second;
+      }
+    return begin->Map.insert(*ci).first->second;
+    }
   StackIter it = begin;
   ++it;
   if (it == end)
     {
     return cmDefinitions::NoDef;
     }
-  Def const& def = cmDefinitions::GetInternal(key, it, end, raise);
+  Def const& def = cmDefinitions::GetInternal(key, it, end, false);
   if (!raise)
     {
-    return def;
+    return begin->LookupCache.insert(
+      MapType::value_type(key, def)).first->second;
     }
   return begin->Map.insert(MapType::value_type(key, def)).first->second;
 }
@@ -45,22 +55,33 @@ cmDefinitions::Def const& cmDefinitions::GetInternal(
 const char* cmDefinitions::Get(const std::string& key,
     StackIter begin, StackIter end)
 {
-  Def const& def = cmDefinitions::GetInternal(key, begin, end, false);
+  // A name that was never interned cannot have been set anywhere.
+  cmInternedString ikey;
+  if (!cmInternedString::Find(key, ikey))
+    {
+    return 0;
+    }
+  Def const& def = cmDefinitions::GetInternal(ikey, begin, end, false);
   return def.Exists? def.c_str() : 0;
 }
 
 void cmDefinitions::Raise(const std::string& key,
                           StackIter begin, StackIter end)
 {
-  cmDefinitions::GetInternal(key, begin, end, true);
+  cmDefinitions::GetInternal(cmInternedString(key), begin, end, true);
 }
 
 bool cmDefinitions::HasKey(const std::string& key,
                            StackIter begin, StackIter end)
 {
+  cmInternedString ikey;
+  if (!cmInternedString::Find(key, ikey))
+    {
+    return false;
+    }
   for (StackIter it = begin; it != end; ++it)
     {
-    MapType::const_iterator i = it->Map.find(key);
+    MapType::const_iterator i = it->Map.find(ikey);
     if (i != it->Map.end())
       {
       return true;
@@ -73,7 +94,7 @@ bool cmDefinitions::HasKey(const std::string& key,
 void cmDefinitions::Set(const std::string& key, const char* value)
 {
   Def def(value);
-  this->Map[key] = def;
+  this->Map[cmInternedString(key)] = def;
 }
 
 //----------------------------------------------------------------------------
@@ -87,7 +108,7 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
     {
     if (!mi->second.Used)
       {
-      keys.push_back(mi->first);
+      keys.push_back(mi->first.str());
       }
     }
   return keys;
@@ -98,7 +119,7 @@ cmDefinitions cmDefinitions::MakeClosure(StackIter begin,
                                          StackIter end)
 {
   cmDefinitions closure;
-  std::set<std::string> undefined;
+  std::set<cmInternedString> undefined;
   for (StackIter it = begin; it != end; ++it)
     {
     // Consider local definitions.
@@ -127,7 +148,7 @@ cmDefinitions cmDefinitions::MakeClosure(StackIter begin,
 std::vector<std::string>
 cmDefinitions::ClosureKeys(StackIter begin, StackIter end)
 {
-  std::set<std::string> bound;
+  std::set<cmInternedString> bound;
   std::vector<std::string> defined;
 
   for (StackIter it = begin; it != end; ++it)
@@ -139,7 +160,7 @@ cmDefinitions::ClosureKeys(StackIter begin, StackIter end)
       // Use this key if it is not already set or unset.
       if(bound.insert(mi->first).second && mi->second.Exists)
         {
-        defined.push_back(mi->first);
+        defined.push_back(mi->first.str());
         }
       }
     }
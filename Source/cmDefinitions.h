@@ -14,6 +14,7 @@
 
 #include "cmStandardIncludes.h"
 
+#include "cmInternedString.h"
 #include "cmLinkedTree.h"
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
@@ -31,7 +32,8 @@
  *
  * This stores the state of variable definitions (set or unset) for
  * one scope.  Sets are always local.  Gets search parent scopes
- * transitively and save results locally.
+ * transitively and remember the result in a per-scope lookup cache
+ * so that repeated reads in nested scopes do not walk the whole chain.
  */
 class cmDefinitions
 {
@@ -78,16 +80,24 @@ private:
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
 #ifdef CMake_HAVE_CXX11_UNORDERED_MAP
-  typedef std::unordered_map<std::string, Def> MapType;
+  typedef std::unordered_map<cmInternedString, Def,
+                             cmInternedString::Hash> MapType;
 #else
-  typedef cmsys::hash_map<std::string, Def> MapType;
+  typedef cmsys::hash_map<cmInternedString, Def,
+                          cmInternedString::Hash> MapType;
 #endif
 #else
-  typedef std::map<std::string, Def> MapType;
+  typedef std::map<cmInternedString, Def> MapType;
 #endif
   MapType Map;
 
-  static Def const& GetInternal(const std::string& key,
+  // Results of lookups that were answered by a parent scope.  Entries
+  // here never shadow Map.  A parent scope is only modified while
+  // this scope is active through PARENT_SCOPE, which localizes the
+  // key in Map first, so cached values cannot go stale.
+  MapType LookupCache;
+
+  static Def const& GetInternal(cmInternedString const& key,
     StackIter begin, StackIter end, bool raise);
 };
 
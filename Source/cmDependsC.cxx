@@ -13,12 +13,20 @@
 
 #include "cmAlgorithms.h"
 #include "cmFileTimeComparison.h"
+#include "cmGeneratedFileStream.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
 #include <cmsys/FStream.hxx>
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmCryptoHash.h"
+# include "cmFileLock.h"
+# include "cmFileLockResult.h"
+#endif
+
 #include <ctype.h> // isspace
+#include <time.h>
 
 
 #define INCLUDE_REGEX_LINE \
@@ -32,6 +40,7 @@
 //----------------------------------------------------------------------------
 cmDependsC::cmDependsC()
 : ValidDeps(0)
+, ScanStartTime(0)
 {
 }
 
@@ -42,6 +51,7 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg,
                    const std::map<std::string, DependencyVector>* validDeps)
 : cmDepends(lg, targetDir)
 , ValidDeps(validDeps)
+, ScanStartTime(static_cast<long>(time(0)))
 {
   cmMakefile* mf = lg->GetMakefile();
 
@@ -85,12 +95,15 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg,
   this->CacheFileName += ".includecache";
 
   this->ReadCacheFile();
+
+  this->SetupSharedCache(lang);
 }
 
 //----------------------------------------------------------------------------
 cmDependsC::~cmDependsC()
 {
   this->WriteCacheFile();
+  this->WriteSharedCacheFile();
   cmDeleteAll(this->FileCache);
 }
 
@@ -159,13 +172,13 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
       if((srcFiles>0)
          || cmSystemTools::FileIsFullPath(current.FileName.c_str()))
         {
-        if(cmSystemTools::FileExists(current.FileName.c_str(), true))
+        if(this->FileExists(current.FileName))
           {
           fullName = current.FileName;
           }
         }
       else if(!current.QuotedLocation.empty() &&
-              cmSystemTools::FileExists(current.QuotedLocation.c_str(), true))
+              this->FileExists(current.QuotedLocation))
         {
         // The include statement producing this entry was a double-quote
         // include and the included file is present in the directory of
@@ -180,22 +193,27 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
           {
           fullName=headerLocationIt->second;
           }
-        else for(std::vector<std::string>::const_iterator i =
-              this->IncludePath.begin(); i != this->IncludePath.end(); ++i)
+        else
           {
-          // Construct the name of the file as if it were in the current
-          // include directory.  Avoid using a leading "./".
+          for(std::vector<std::string>::const_iterator i =
+                this->IncludePath.begin(); i != this->IncludePath.end(); ++i)
+            {
+            // Construct the name of the file as if it were in the current
+            // include directory.  Avoid using a leading "./".
 
-          tempPathStr =
-            cmSystemTools::CollapseCombinedPath(*i, current.FileName);
+            tempPathStr =
+              cmSystemTools::CollapseCombinedPath(*i, current.FileName);
 
-          // Look for the file in this location.
-          if(cmSystemTools::FileExists(tempPathStr.c_str(), true))
-            {
-            fullName = tempPathStr;
-            HeaderLocationCache[current.FileName]=fullName;
-            break;
+            // Look for the file in this location.
+            if(this->FileExists(tempPathStr))
+              {
+              fullName = tempPathStr;
+              break;
+              }
             }
+          // Remember the result even if the file was not found so that
+          // other sources including it do not search the path again.
+          this->HeaderLocationCache[current.FileName]=fullName;
           }
         }
 
@@ -216,15 +234,24 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
         scanned.insert(fullName);
 
         // Check whether this file is already in the cache
+        cmIncludeLines* cacheEntry = 0;
         std::map<std::string, cmIncludeLines*>::iterator fileIt=
           this->FileCache.find(fullName);
         if (fileIt!=this->FileCache.end())
           {
-          fileIt->second->Used=true;
+          cacheEntry = fileIt->second;
+          }
+        else
+          {
+          cacheEntry = this->LoadFromSharedCache(fullName);
+          }
+        if (cacheEntry)
+          {
+          cacheEntry->Used=true;
           dependencies.insert(fullName);
           for (std::vector<UnscannedEntry>::const_iterator incIt=
-                fileIt->second->UnscannedEntries.begin();
-              incIt!=fileIt->second->UnscannedEntries.end(); ++incIt)
+                cacheEntry->UnscannedEntries.begin();
+              incIt!=cacheEntry->UnscannedEntries.end(); ++incIt)
             {
             if (this->Encountered.find(incIt->FileName) ==
                 this->Encountered.end())
@@ -251,8 +278,25 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
 
               // Scan this file for new dependencies.  Pass the directory
               // containing the file to handle double-quote includes.
+              long mtime = 0;
+              if(!this->SharedCacheFileName.empty())
+                {
+                mtime = cmSystemTools::ModifiedTime(fullName);
+                }
               std::string dir = cmSystemTools::GetFilenamePath(fullName);
               this->Scan(fin, dir.c_str(), fullName);
+
+              // Share the result with other targets unless the file
+              // changed so recently that a later modification within
+              // the same second would go unnoticed.
+              if(!this->SharedCacheFileName.empty() &&
+                 mtime > 0 && mtime < this->ScanStartTime)
+                {
+                SharedCacheEntry& shared = this->SharedCacheUpdates[fullName];
+                shared.MTime = mtime;
+                shared.UnscannedEntries =
+                  this->FileCache[fullName]->UnscannedEntries;
+                }
               }
             else
               {
@@ -280,10 +324,7 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   for(std::set<std::string>::const_iterator i=dependencies.begin();
       i != dependencies.end(); ++i)
     {
-    makeDepends << obj_m << ": " <<
-      this->LocalGenerator->Convert(*i,
-                                    cmLocalGenerator::HOME_OUTPUT,
-                                    cmLocalGenerator::MAKERULE)
+    makeDepends << obj_m << ": " << this->ConvertToMakeRulePath(*i)
                 << std::endl;
     internalDepends << " " << *i << std::endl;
     }
@@ -292,6 +333,35 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool cmDependsC::FileExists(std::string const& path)
+{
+  std::map<std::string, bool>::iterator i =
+    this->FileExistsCache.find(path);
+  if(i == this->FileExistsCache.end())
+    {
+    bool exists = cmSystemTools::FileExists(path.c_str(), true);
+    i = this->FileExistsCache.insert(std::make_pair(path, exists)).first;
+    }
+  return i->second;
+}
+
+//----------------------------------------------------------------------------
+std::string const& cmDependsC::ConvertToMakeRulePath(std::string const& path)
+{
+  std::map<std::string, std::string>::iterator i =
+    this->MakeRulePathCache.find(path);
+  if(i == this->MakeRulePathCache.end())
+    {
+    std::string converted =
+      this->LocalGenerator->Convert(path,
+                                    cmLocalGenerator::HOME_OUTPUT,
+                                    cmLocalGenerator::MAKERULE);
+    i = this->MakeRulePathCache.insert(std::make_pair(path, converted)).first;
+    }
+  return i->second;
+}
+
 //----------------------------------------------------------------------------
 void cmDependsC::ReadCacheFile()
 {
@@ -426,6 +496,183 @@ void cmDependsC::WriteCacheFile() const
    }
 }
 
+//----------------------------------------------------------------------------
+void cmDependsC::SetupSharedCache(const std::string& lang)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Targets scanned with different rules cannot share results, so
+  // name the shared cache after a hash of the rules.
+  std::string rules = this->IncludeRegexLineString;
+  rules += "\n";
+  rules += this->IncludeRegexScanString;
+  rules += "\n";
+  rules += this->IncludeRegexComplainString;
+  rules += "\n";
+  rules += this->IncludeRegexTransformString;
+  cmCryptoHashMD5 md5;
+  std::string dir = this->LocalGenerator->GetBinaryDirectory();
+  dir += cmake::GetCMakeFilesDirectory();
+  dir += "/IncludeCache";
+  if(!cmSystemTools::MakeDirectory(dir.c_str()))
+    {
+    return;
+    }
+  this->SharedCacheFileName = dir;
+  this->SharedCacheFileName += "/";
+  this->SharedCacheFileName += lang;
+  this->SharedCacheFileName += "-";
+  this->SharedCacheFileName += md5.HashString(rules).substr(0, 16);
+  this->SharedCacheFileName += ".includecache";
+
+  // The file is replaced atomically by writers so it can be read
+  // without holding the lock.
+  this->ReadSharedCacheFile(this->SharedCache);
+#else
+  static_cast<void>(lang);
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool cmDependsC::ReadSharedCacheFile(SharedCacheType& entries) const
+{
+  cmsys::ifstream fin(this->SharedCacheFileName.c_str());
+  if(!fin)
+    {
+    return false;
+    }
+
+  // The file starts with the rules used to produce it.
+  std::string line;
+  const std::string* rules[] = {
+    &this->IncludeRegexLineString,
+    &this->IncludeRegexScanString,
+    &this->IncludeRegexComplainString,
+    &this->IncludeRegexTransformString
+  };
+  for(size_t i = 0; i < sizeof(rules)/sizeof(rules[0]); ++i)
+    {
+    if(!cmSystemTools::GetLineFromStream(fin, line) || line != *rules[i])
+      {
+      return false;
+      }
+    }
+
+  // Each entry is the name of the scanned file, its modification time
+  // and pairs of lines for the included files, followed by an empty
+  // line.
+  SharedCacheEntry* entry = 0;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    if(line.empty())
+      {
+      entry = 0;
+      continue;
+      }
+    if(!entry)
+      {
+      std::string mtime;
+      if(!cmSystemTools::GetLineFromStream(fin, mtime))
+        {
+        break;
+        }
+      entry = &entries[line];
+      entry->MTime = atol(mtime.c_str());
+      entry->UnscannedEntries.clear();
+      continue;
+      }
+    UnscannedEntry inc;
+    inc.FileName = line;
+    if(!cmSystemTools::GetLineFromStream(fin, line))
+      {
+      break;
+      }
+    if(line != "-")
+      {
+      inc.QuotedLocation = line;
+      }
+    entry->UnscannedEntries.push_back(inc);
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void cmDependsC::WriteSharedCacheFile()
+{
+  if(this->SharedCacheFileName.empty() || this->SharedCacheUpdates.empty())
+    {
+    return;
+    }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Other depend steps may run concurrently under "make -j".  Hold the
+  // lock while merging our results with the current file contents so
+  // that no updates are lost.  Just skip sharing if the lock cannot be
+  // taken, e.g. on file systems without lock support.
+  std::string lockFile = this->SharedCacheFileName + ".lock";
+  cmFileLock lock;
+  if(!cmSystemTools::Touch(lockFile, true) ||
+     !lock.Lock(lockFile, 60).IsOk())
+    {
+    return;
+    }
+
+  SharedCacheType entries;
+  this->ReadSharedCacheFile(entries);
+  for(SharedCacheType::const_iterator i = this->SharedCacheUpdates.begin();
+      i != this->SharedCacheUpdates.end(); ++i)
+    {
+    entries[i->first] = i->second;
+    }
+
+  {
+  cmGeneratedFileStream cacheOut(this->SharedCacheFileName.c_str(), true);
+  if(!cacheOut)
+    {
+    return;
+    }
+  cacheOut << this->IncludeRegexLineString << "\n";
+  cacheOut << this->IncludeRegexScanString << "\n";
+  cacheOut << this->IncludeRegexComplainString << "\n";
+  cacheOut << this->IncludeRegexTransformString << "\n";
+  for(SharedCacheType::const_iterator i = entries.begin();
+      i != entries.end(); ++i)
+    {
+    cacheOut << i->first << "\n" << i->second.MTime << "\n";
+    for(std::vector<UnscannedEntry>::const_iterator
+          incIt = i->second.UnscannedEntries.begin();
+        incIt != i->second.UnscannedEntries.end(); ++incIt)
+      {
+      cacheOut << incIt->FileName << "\n";
+      if(incIt->QuotedLocation.empty())
+        {
+        cacheOut << "-\n";
+        }
+      else
+        {
+        cacheOut << incIt->QuotedLocation << "\n";
+        }
+      }
+    cacheOut << "\n";
+    }
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+cmDependsC::cmIncludeLines*
+cmDependsC::LoadFromSharedCache(std::string const& fullName)
+{
+  SharedCacheType::const_iterator i = this->SharedCache.find(fullName);
+  if(i == this->SharedCache.end() ||
+     i->second.MTime != cmSystemTools::ModifiedTime(fullName))
+    {
+    return 0;
+    }
+  cmIncludeLines* cacheEntry = new cmIncludeLines;
+  cacheEntry->UnscannedEntries = i->second.UnscannedEntries;
+  this->FileCache[fullName] = cacheEntry;
+  return cacheEntry;
+}
+
 //----------------------------------------------------------------------------
 void cmDependsC::Scan(std::istream& is, const char* directory,
   const std::string& fullName)
@@ -86,10 +86,39 @@ protected:
   std::map<std::string, cmIncludeLines *> FileCache;
   std::map<std::string, std::string> HeaderLocationCache;
 
+  // Resolution results shared by all sources scanned by this instance.
+  // Every object file of a target walks mostly the same headers, so
+  // remember which paths exist and how each dependency is written in
+  // the make rules instead of asking the file system again.
+  std::map<std::string, bool> FileExistsCache;
+  std::map<std::string, std::string> MakeRulePathCache;
+  bool FileExists(std::string const& path);
+  std::string const& ConvertToMakeRulePath(std::string const& path);
+
   std::string CacheFileName;
 
   void WriteCacheFile() const;
   void ReadCacheFile();
+
+  // Cache of scanned files shared by all targets in the build tree
+  // that use the same scanning rules.  Entries record the modification
+  // time of the file and are used only while it is unchanged.
+  struct SharedCacheEntry
+  {
+    SharedCacheEntry(): MTime(0) {}
+    long MTime;
+    std::vector<UnscannedEntry> UnscannedEntries;
+  };
+  typedef std::map<std::string, SharedCacheEntry> SharedCacheType;
+  SharedCacheType SharedCache;
+  SharedCacheType SharedCacheUpdates;
+  std::string SharedCacheFileName;
+  long ScanStartTime;
+
+  void SetupSharedCache(const std::string& lang);
+  bool ReadSharedCacheFile(SharedCacheType& entries) const;
+  void WriteSharedCacheFile();
+  cmIncludeLines* LoadFromSharedCache(std::string const& fullName);
 private:
   cmDependsC(cmDependsC const&); // Purposely not implemented.
   void operator=(cmDependsC const&); // Purposely not implemented.
@@ -0,0 +1,199 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmDependsCompiler.h"
+
+#include "cmFileTimeComparison.h"
+#include "cmLocalGenerator.h"
+#include "cmSystemTools.h"
+#include <cmsys/FStream.hxx>
+
+//----------------------------------------------------------------------------
+cmDependsCompiler::cmDependsCompiler(cmLocalGenerator* lg):
+  LocalGenerator(lg), FileComparison(0), Verbose(false)
+{
+}
+
+//----------------------------------------------------------------------------
+bool cmDependsCompiler::CheckDepfiles(std::vector<std::string> const& pairs,
+                                      std::string const& internalFile)
+{
+  for(std::vector<std::string>::const_iterator i = pairs.begin();
+      i != pairs.end() && (i+1) != pairs.end(); i += 2)
+    {
+    std::string const& depfile = *(i+1);
+
+    // A missing depfile belongs to an object that has not been compiled
+    // yet.  It will be merged after the compilation writes it.
+    int result;
+    if(this->FileComparison->FileTimeCompare(internalFile.c_str(),
+                                             depfile.c_str(), &result) &&
+       result < 0)
+      {
+      if(this->Verbose)
+        {
+        std::ostringstream msg;
+        msg << "Depfile \"" << depfile
+            << "\" is newer than depender \""
+            << internalFile << "\"." << std::endl;
+        cmSystemTools::Stdout(msg.str().c_str());
+        }
+      return true;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void cmDependsCompiler::Write(std::vector<std::string> const& pairs,
+                              std::ostream& makeDepends)
+{
+  // The compiler runs in the current output directory so relative
+  // paths in the depfiles are relative to it.
+  std::string const binDir = this->LocalGenerator->GetCurrentBinaryDirectory();
+
+  std::set<std::string> headers;
+  std::vector<std::string> depends;
+  for(std::vector<std::string>::const_iterator i = pairs.begin();
+      i != pairs.end() && (i+1) != pairs.end(); i += 2)
+    {
+    std::string const& obj = *i;
+    std::string const& depfile = *(i+1);
+    depends.clear();
+    if(!ParseDepfile(depfile, depends) || depends.empty())
+      {
+      continue;
+      }
+
+    // Write the dependencies the same way as cmDependsC does.
+    std::string obj_m =
+      this->LocalGenerator->ConvertToOutputFormat(
+        this->LocalGenerator->Convert(obj, cmLocalGenerator::HOME_OUTPUT),
+        cmLocalGenerator::MAKERULE);
+    std::set<std::string> written;
+    for(std::vector<std::string>::const_iterator d = depends.begin();
+        d != depends.end(); ++d)
+      {
+      std::string dep = cmSystemTools::CollapseFullPath(*d, binDir);
+      if(!written.insert(dep).second)
+        {
+        continue;
+        }
+      makeDepends << obj_m << ": " << this->ConvertToMakeRulePath(dep)
+                  << std::endl;
+
+      // The first dependency is the source itself.
+      if(d != depends.begin())
+        {
+        headers.insert(dep);
+        }
+      }
+    makeDepends << std::endl;
+    }
+
+  // Do not fail when a header has been removed since the compilation.
+  if(!headers.empty())
+    {
+    makeDepends << "# Headers may be removed without regenerating.\n";
+    for(std::set<std::string>::const_iterator h = headers.begin();
+        h != headers.end(); ++h)
+      {
+      makeDepends << this->ConvertToMakeRulePath(*h) << ":" << std::endl;
+      }
+    makeDepends << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmDependsCompiler::ParseDepfile(std::string const& fileName,
+                                     std::vector<std::string>& depends)
+{
+  cmsys::ifstream fin(fileName.c_str(), std::ios::in | std::ios::binary);
+  if(!fin)
+    {
+    return false;
+    }
+  std::string content((std::istreambuf_iterator<char>(fin)),
+                      std::istreambuf_iterator<char>());
+
+  // Tokens before the colon of each rule name its targets and the rest
+  // of the logical line lists its dependencies.  Backslash-newline
+  // continues a line, and spaces, '#' and '$' are escaped in paths.
+  bool inDepends = false;
+  std::string token;
+  std::string::size_type const n = content.size();
+  for(std::string::size_type i = 0; i <= n; ++i)
+    {
+    char c = i < n ? content[i] : '\n';
+    if(c == '\\' && i+1 < n)
+      {
+      char next = content[i+1];
+      if(next == ' ' || next == '#')
+        {
+        token += next;
+        ++i;
+        continue;
+        }
+      if(next == '\n' || (next == '\r' && i+2 < n && content[i+2] == '\n'))
+        {
+        i += next == '\n' ? 1 : 2;
+        c = ' ';
+        }
+      }
+    else if(c == '$' && i+1 < n && content[i+1] == '$')
+      {
+      token += c;
+      ++i;
+      continue;
+      }
+
+    if(c != ' ' && c != '\t' && c != '\r' && c != '\n')
+      {
+      token += c;
+      continue;
+      }
+
+    if(!token.empty())
+      {
+      if(inDepends)
+        {
+        depends.push_back(token);
+        }
+      else if(token[token.size()-1] == ':')
+        {
+        inDepends = true;
+        }
+      token.clear();
+      }
+    if(c == '\n')
+      {
+      inDepends = false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::string const&
+cmDependsCompiler::ConvertToMakeRulePath(std::string const& path)
+{
+  std::map<std::string, std::string>::iterator i =
+    this->MakeRulePathCache.find(path);
+  if(i == this->MakeRulePathCache.end())
+    {
+    std::string converted =
+      this->LocalGenerator->Convert(path,
+                                    cmLocalGenerator::HOME_OUTPUT,
+                                    cmLocalGenerator::MAKERULE);
+    i = this->MakeRulePathCache.insert(std::make_pair(path, converted)).first;
+    }
+  return i->second;
+}
@@ -0,0 +1,72 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmDependsCompiler_h
+#define cmDependsCompiler_h
+
+#include "cmStandardIncludes.h"
+
+class cmFileTimeComparison;
+class cmLocalGenerator;
+
+/** \class cmDependsCompiler
+ * \brief Merge depfiles written by the compiler into make dependencies.
+ *
+ * cmDependsCompiler reads the make-style depfiles that GNU-compatible
+ * compilers write next to each object file with -MD and folds them into
+ * the depend.make file of the target.  No source is scanned.  An empty
+ * rule is written for every dependency so that a removed header only
+ * causes the objects including it to be rebuilt.
+ */
+class cmDependsCompiler
+{
+public:
+  cmDependsCompiler(cmLocalGenerator* lg);
+
+  /** Should this be verbose in its output.  */
+  void SetVerbose(bool verb) { this->Verbose = verb; }
+
+  /** Set the file comparison object.  */
+  void SetFileComparison(cmFileTimeComparison* fc)
+    { this->FileComparison = fc; }
+
+  /**
+   * Return whether any depfile of the list of object and depfile pairs
+   * is newer than the given internal dependency file.
+   */
+  bool CheckDepfiles(std::vector<std::string> const& pairs,
+                     std::string const& internalFile);
+
+  /**
+   * Write make rules for the dependencies listed by the depfiles of
+   * the list of object and depfile pairs.  Objects whose depfile does
+   * not exist yet have not been compiled and get no rules.
+   */
+  void Write(std::vector<std::string> const& pairs,
+             std::ostream& makeDepends);
+
+  /**
+   * Parse a make-style depfile and append the dependencies it lists
+   * for its targets.  Relative paths are left unchanged.
+   */
+  static bool ParseDepfile(std::string const& fileName,
+                           std::vector<std::string>& depends);
+
+private:
+  std::string const& ConvertToMakeRulePath(std::string const& path);
+
+  cmLocalGenerator* LocalGenerator;
+  cmFileTimeComparison* FileComparison;
+  bool Verbose;
+  std::map<std::string, std::string> MakeRulePathCache;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmGenerateProfile.h"
+
+#include "cmGeneratedFileStream.h"
+#include "cmSystemTools.h"
+
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+#if !defined(_WIN32)
+# include <sys/resource.h>
+#endif
+
+//----------------------------------------------------------------------------
+// Get the peak resident memory of this process in KiB, or -1 if the
+// platform does not provide it.
+static long cmGenerateProfilePeakMemory()
+{
+#if defined(_WIN32)
+  return -1;
+#else
+  struct rusage ru;
+  if(getrusage(RUSAGE_SELF, &ru) != 0)
+    {
+    return -1;
+    }
+# if defined(__APPLE__)
+  // Darwin reports bytes instead of KiB.
+  return static_cast<long>(ru.ru_maxrss / 1024);
+# else
+  return static_cast<long>(ru.ru_maxrss);
+# endif
+#endif
+}
+
+//----------------------------------------------------------------------------
+cmGenerateProfile::cmGenerateProfile(std::string const& fileName):
+  FileName(fileName), Origin(cmSystemTools::GetTime())
+{
+}
+
+//----------------------------------------------------------------------------
+void cmGenerateProfile::StartPhase(std::string const& name,
+                                   std::string const& detail)
+{
+  size_t index = this->Phases.size();
+  Phase p;
+  p.Name = name;
+  p.Detail = detail;
+  p.Start = cmSystemTools::GetTime();
+  p.Seconds = 0;
+  p.PeakMemory = -1;
+  this->Phases.push_back(p);
+  if(this->Open.empty())
+    {
+    this->TopPhases.push_back(index);
+    }
+  else
+    {
+    this->Phases[this->Open.back()].Children.push_back(index);
+    }
+  this->Open.push_back(index);
+}
+
+//----------------------------------------------------------------------------
+void cmGenerateProfile::StopPhase()
+{
+  Phase& p = this->Phases[this->Open.back()];
+  p.Seconds = cmSystemTools::GetTime() - p.Start;
+  p.PeakMemory = cmGenerateProfilePeakMemory();
+  this->Open.pop_back();
+}
+
+//----------------------------------------------------------------------------
+void cmGenerateProfile::WritePhases(Json::Value& out,
+                                    std::vector<size_t> const& indexes) const
+{
+  out = Json::arrayValue;
+  for(std::vector<size_t>::const_iterator i = indexes.begin();
+      i != indexes.end(); ++i)
+    {
+    Phase const& p = this->Phases[*i];
+    Json::Value& phase = out.append(Json::objectValue);
+    phase["name"] = p.Name;
+    if(!p.Detail.empty())
+      {
+      phase["detail"] = p.Detail;
+      }
+    phase["start"] = p.Start - this->Origin;
+    phase["seconds"] = p.Seconds;
+    if(p.PeakMemory >= 0)
+      {
+      phase["peakMemoryKiB"] = static_cast<Json::Int64>(p.PeakMemory);
+      }
+    else
+      {
+      phase["peakMemoryKiB"] = Json::nullValue;
+      }
+    if(!p.Children.empty())
+      {
+      this->WritePhases(phase["phases"], p.Children);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmGenerateProfile::Write()
+{
+  Json::Value root(Json::objectValue);
+  this->WritePhases(root["phases"], this->TopPhases);
+
+  cmGeneratedFileStream fout(this->FileName.c_str());
+  if(!fout)
+    {
+    return false;
+    }
+  fout << root;
+  return fout.Close();
+}
+
+//----------------------------------------------------------------------------
+cmGenerateProfile::Scope::Scope(cmGenerateProfile* profile, const char* name,
+                                std::string const& detail):
+  Profile(profile)
+{
+  if(this->Profile)
+    {
+    this->Profile->StartPhase(name, detail);
+    }
+}
+
+//----------------------------------------------------------------------------
+cmGenerateProfile::Scope::~Scope()
+{
+  if(this->Profile)
+    {
+    this->Profile->StopPhase();
+    }
+}
@@ -0,0 +1,72 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmGenerateProfile_h
+#define cmGenerateProfile_h
+
+#include "cmStandardIncludes.h"
+
+namespace Json
+{
+  class Value;
+}
+
+/** \class cmGenerateProfile
+ * \brief Record the duration and memory use of generate step phases.
+ *
+ * cmGenerateProfile collects a tree of named phases with their wall
+ * clock duration and the peak resident memory of the process at the
+ * end of each phase, and writes them to a JSON file.
+ */
+class cmGenerateProfile
+{
+public:
+  cmGenerateProfile(std::string const& fileName);
+
+  /** Begin and end a phase nested in the currently open phase.  */
+  void StartPhase(std::string const& name, std::string const& detail);
+  void StopPhase();
+
+  /** Write all recorded phases to the output file.  */
+  bool Write();
+
+  /** Record one phase for the lifetime of the object.  */
+  class Scope
+  {
+  public:
+    Scope(cmGenerateProfile* profile, const char* name,
+          std::string const& detail = std::string());
+    ~Scope();
+  private:
+    cmGenerateProfile* Profile;
+  };
+
+private:
+  struct Phase
+  {
+    std::string Name;
+    std::string Detail;
+    double Start;
+    double Seconds;
+    long PeakMemory;
+    std::vector<size_t> Children;
+  };
+
+  void WritePhases(Json::Value& out, std::vector<size_t> const& indexes) const;
+
+  std::string FileName;
+  double Origin;
+  std::vector<Phase> Phases;
+  std::vector<size_t> TopPhases;
+  std::vector<size_t> Open;
+};
+
+#endif
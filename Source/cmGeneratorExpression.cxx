@@ -78,17 +78,81 @@ const char *cmCompiledGeneratorExpression::Evaluate(
   return this->EvaluateWithContext(context, dagChecker);
 }
 
+//----------------------------------------------------------------------------
+cmGeneratorExpression::Statistics& cmGeneratorExpression::GetStatistics()
+{
+  static Statistics statistics;
+  return statistics;
+}
+
+//----------------------------------------------------------------------------
+bool cmCompiledGeneratorExpression::MemoKey::operator<(
+                                              MemoKey const& r) const
+{
+  if (this->LG != r.LG)
+    {
+    return this->LG < r.LG;
+    }
+  if (this->HeadTarget != r.HeadTarget)
+    {
+    return this->HeadTarget < r.HeadTarget;
+    }
+  if (this->CurrentTarget != r.CurrentTarget)
+    {
+    return this->CurrentTarget < r.CurrentTarget;
+    }
+  if (this->EvaluateForBuildsystem != r.EvaluateForBuildsystem)
+    {
+    return this->EvaluateForBuildsystem < r.EvaluateForBuildsystem;
+    }
+  if (this->Config != r.Config)
+    {
+    return this->Config < r.Config;
+    }
+  return this->Language < r.Language;
+}
+
 //----------------------------------------------------------------------------
 const char* cmCompiledGeneratorExpression::EvaluateWithContext(
                             cmGeneratorExpressionContext& context,
                             cmGeneratorExpressionDAGChecker *dagChecker) const
 {
+  cmGeneratorExpression::Statistics& stats =
+    cmGeneratorExpression::GetStatistics();
   if (!this->NeedsEvaluation)
     {
+    ++stats.Literal;
     return this->Input.c_str();
     }
 
-  this->Output = "";
+  MemoKey key;
+  key.LG = context.LG;
+  key.Config = context.Config;
+  key.Language = context.Language;
+  key.HeadTarget = context.HeadTarget;
+  key.CurrentTarget = context.CurrentTarget;
+  key.EvaluateForBuildsystem = context.EvaluateForBuildsystem;
+  std::map<MemoKey, MemoEntry>::const_iterator mi = this->Memo.find(key);
+  if (mi != this->Memo.end())
+    {
+    // Memoized results come only from evaluations that used no nodes
+    // reporting targets, properties or language standards.
+    ++stats.MemoHits;
+    context.HadContextSensitiveCondition =
+      mi->second.HadContextSensitiveCondition;
+    this->MaxLanguageStandard.clear();
+    this->HadContextSensitiveCondition =
+      mi->second.HadContextSensitiveCondition;
+    this->HadHeadSensitiveCondition = false;
+    this->SourceSensitiveTargets.clear();
+    this->DependTargets.clear();
+    this->AllTargetsSeen.clear();
+    return mi->second.Output.c_str();
+    }
+
+  // Build the result locally because the evaluators may evaluate this
+  // same expression recursively for another target.
+  std::string output;
 
   std::vector<cmGeneratorExpressionEvaluator*>::const_iterator it
                                                   = this->Evaluators.begin();
@@ -97,13 +161,13 @@ const char* cmCompiledGeneratorExpression::EvaluateWithContext(
 
   for ( ; it != end; ++it)
     {
-    this->Output += (*it)->Evaluate(&context, dagChecker);
+    output += (*it)->Evaluate(&context, dagChecker);
 
     this->SeenTargetProperties.insert(context.SeenTargetProperties.begin(),
                                       context.SeenTargetProperties.end());
     if (context.HadError)
       {
-      this->Output = "";
+      output = "";
       break;
       }
     }
@@ -119,6 +183,17 @@ const char* cmCompiledGeneratorExpression::EvaluateWithContext(
 
   this->DependTargets = context.DependTargets;
   this->AllTargetsSeen = context.AllTargets;
+
+  if (!context.HadError && context.Memoizable)
+    {
+    ++stats.MemoMisses;
+    MemoEntry& entry = this->Memo[key];
+    entry.Output = output;
+    entry.HadContextSensitiveCondition = context.HadContextSensitiveCondition;
+    return entry.Output.c_str();
+    }
+  ++stats.NotMemoizable;
+  this->Output = output;
   // TODO: Return a std::string from here instead?
   return this->Output.c_str();
 }
@@ -131,6 +206,13 @@ cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
     HadHeadSensitiveCondition(false),
     EvaluateForBuildsystem(false)
 {
+  // Skip tokenizing inputs that cannot contain a generator expression.
+  this->NeedsEvaluation = this->Input.find("$<") != std::string::npos;
+  if (!this->NeedsEvaluation)
+    {
+    return;
+    }
+
   cmGeneratorExpressionLexer l;
   std::vector<cmGeneratorExpressionToken> tokens =
                                               l.Tokenize(this->Input);
@@ -27,6 +27,7 @@ class cmListFileBacktrace;
 struct cmGeneratorExpressionEvaluator;
 struct cmGeneratorExpressionContext;
 struct cmGeneratorExpressionDAGChecker;
+struct cmGeneratorExpressionNode;
 
 class cmCompiledGeneratorExpression;
 
@@ -69,6 +70,22 @@ public:
   static bool IsValidTargetName(const std::string &input);
 
   static std::string StripEmptyListElements(const std::string &input);
+
+  /** Counts of how evaluations of compiled expressions were satisfied.  */
+  struct Statistics
+  {
+    Statistics(): Literal(0), MemoHits(0), MemoMisses(0), NotMemoizable(0)
+      {}
+    // Inputs without any generator expression, returned unchanged.
+    unsigned long Literal;
+    // Evaluations answered by a memoized result.
+    unsigned long MemoHits;
+    // Evaluations whose result was computed and memoized.
+    unsigned long MemoMisses;
+    // Evaluations that used state beyond the memo key.
+    unsigned long NotMemoizable;
+  };
+  static Statistics& GetStatistics();
 private:
   cmGeneratorExpression(const cmGeneratorExpression &);
   void operator=(const cmGeneratorExpression &);
@@ -141,6 +158,7 @@ private:
               const std::string& input);
 
   friend class cmGeneratorExpression;
+  friend struct cmGeneratorExpressionNode;
 
   cmCompiledGeneratorExpression(const cmCompiledGeneratorExpression &);
   void operator=(const cmCompiledGeneratorExpression &);
@@ -160,6 +178,24 @@ private:
   mutable bool HadHeadSensitiveCondition;
   mutable std::set<cmGeneratorTarget const*>  SourceSensitiveTargets;
   bool EvaluateForBuildsystem;
+
+  // Results of evaluations that depended only on the key.
+  struct MemoKey
+  {
+    cmLocalGenerator* LG;
+    std::string Config;
+    std::string Language;
+    cmGeneratorTarget const* HeadTarget;
+    cmGeneratorTarget const* CurrentTarget;
+    bool EvaluateForBuildsystem;
+    bool operator<(MemoKey const& r) const;
+  };
+  struct MemoEntry
+  {
+    std::string Output;
+    bool HadContextSensitiveCondition;
+  };
+  mutable std::map<MemoKey, MemoEntry> Memo;
 };
 
 #endif
@@ -31,6 +31,7 @@ cmGeneratorExpressionContext::cmGeneratorExpressionContext(
     HadError(false),
     HadContextSensitiveCondition(false),
     HadHeadSensitiveCondition(false),
-    EvaluateForBuildsystem(evaluateForBuildsystem)
+    EvaluateForBuildsystem(evaluateForBuildsystem),
+    Memoizable(true)
 {
 }
@@ -52,6 +52,8 @@ struct cmGeneratorExpressionContext
   bool HadContextSensitiveCondition;
   bool HadHeadSensitiveCondition;
   bool EvaluateForBuildsystem;
+  // Cleared by any node whose result may not be memoized.
+  bool Memoizable;
 };
 
 #endif
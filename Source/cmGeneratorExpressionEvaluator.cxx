@@ -124,6 +124,11 @@ std::string GeneratorExpressionContent::Evaluate(
     return std::string();
     }
 
+  if (!node->IsMemoizable())
+    {
+    context->Memoizable = false;
+    }
+
   if (!node->GeneratesContent())
     {
     if (node->NumExpectedParameters() == 1
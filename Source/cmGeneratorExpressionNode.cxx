@@ -25,23 +25,33 @@ std::string cmGeneratorExpressionNode::EvaluateDependentExpression(
     cmGeneratorTarget const* currentTarget,
     cmGeneratorExpressionDAGChecker *dagChecker)
 {
-  cmGeneratorExpression ge(context->Backtrace);
-  cmsys::auto_ptr<cmCompiledGeneratorExpression> cge = ge.Parse(prop);
-  cge->SetEvaluateForBuildsystem(context->EvaluateForBuildsystem);
-  std::string result = cge->Evaluate(lg,
+  // Most property values contain no generator expressions at all.
+  if (prop.find("$<") == std::string::npos)
+    {
+    ++cmGeneratorExpression::GetStatistics().Literal;
+    return prop;
+    }
+  cmCompiledGeneratorExpression const& cge =
+    lg->GetGlobalGenerator()->GetDependentGeneratorExpression(prop);
+  cmGeneratorExpressionContext dependentContext(lg,
                         context->Config,
                         context->Quiet,
                         headTarget,
-                        currentTarget,
-                        dagChecker,
+                        currentTarget ? currentTarget : headTarget,
+                        context->EvaluateForBuildsystem,
+                        context->Backtrace,
                         context->Language);
-  if (cge->GetHadContextSensitiveCondition())
+  std::string result = cge.EvaluateWithContext(dependentContext, dagChecker);
+  if (!dependentContext.HadError)
     {
-    context->HadContextSensitiveCondition = true;
-    }
-  if (cge->GetHadHeadSensitiveCondition())
-    {
-    context->HadHeadSensitiveCondition = true;
+    if (dependentContext.HadContextSensitiveCondition)
+      {
+      context->HadContextSensitiveCondition = true;
+      }
+    if (dependentContext.HadHeadSensitiveCondition)
+      {
+      context->HadHeadSensitiveCondition = true;
+      }
     }
   return result;
 }
@@ -51,6 +61,8 @@ static const struct ZeroNode : public cmGeneratorExpressionNode
 {
   ZeroNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual bool GeneratesContent() const { return false; }
 
   virtual bool AcceptsArbitraryContentParameter() const { return true; }
@@ -69,6 +81,8 @@ static const struct OneNode : public cmGeneratorExpressionNode
 {
   OneNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual bool AcceptsArbitraryContentParameter() const { return true; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -91,6 +105,7 @@ static const struct ZeroNode installInterfaceNode;
 static const struct OP ## Node : public cmGeneratorExpressionNode \
 { \
   OP ## Node () {} \
+  virtual bool IsMemoizable() const { return true; } \
   virtual int NumExpectedParameters() const { return OneOrMoreParameters; } \
  \
   std::string Evaluate(const std::vector<std::string> &parameters, \
@@ -127,6 +142,8 @@ static const struct NotNode : public cmGeneratorExpressionNode
 {
   NotNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   std::string Evaluate(const std::vector<std::string> &parameters,
                        cmGeneratorExpressionContext *context,
                        const GeneratorExpressionContent *content,
@@ -147,6 +164,8 @@ static const struct BoolNode : public cmGeneratorExpressionNode
 {
   BoolNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 1; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -163,6 +182,8 @@ static const struct StrEqualNode : public cmGeneratorExpressionNode
 {
   StrEqualNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 2; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -179,6 +200,8 @@ static const struct EqualNode : public cmGeneratorExpressionNode
 {
   EqualNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 2; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -265,6 +288,8 @@ static const struct LowerCaseNode : public cmGeneratorExpressionNode
 {
   LowerCaseNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   bool AcceptsArbitraryContentParameter() const { return true; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -281,6 +306,8 @@ static const struct UpperCaseNode : public cmGeneratorExpressionNode
 {
   UpperCaseNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   bool AcceptsArbitraryContentParameter() const { return true; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -297,6 +324,8 @@ static const struct MakeCIdentifierNode : public cmGeneratorExpressionNode
 {
   MakeCIdentifierNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   bool AcceptsArbitraryContentParameter() const { return true; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -313,6 +342,8 @@ static const struct Angle_RNode : public cmGeneratorExpressionNode
 {
   Angle_RNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 0; }
 
   std::string Evaluate(const std::vector<std::string> &,
@@ -329,6 +360,8 @@ static const struct CommaNode : public cmGeneratorExpressionNode
 {
   CommaNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 0; }
 
   std::string Evaluate(const std::vector<std::string> &,
@@ -345,6 +378,8 @@ static const struct SemicolonNode : public cmGeneratorExpressionNode
 {
   SemicolonNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 0; }
 
   std::string Evaluate(const std::vector<std::string> &,
@@ -466,6 +501,8 @@ struct CompilerVersionNode : public cmGeneratorExpressionNode
 {
   CompilerVersionNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return OneOrZeroParameters; }
 
   std::string EvaluateWithLanguage(const std::vector<std::string> &parameters,
@@ -550,6 +587,8 @@ struct PlatformIdNode : public cmGeneratorExpressionNode
 {
   PlatformIdNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return OneOrZeroParameters; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -582,6 +621,8 @@ static const struct VersionGreaterNode : public cmGeneratorExpressionNode
 {
   VersionGreaterNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 2; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -600,6 +641,8 @@ static const struct VersionLessNode : public cmGeneratorExpressionNode
 {
   VersionLessNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 2; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -618,6 +661,8 @@ static const struct VersionEqualNode : public cmGeneratorExpressionNode
 {
   VersionEqualNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 2; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -654,6 +699,8 @@ static const struct ConfigurationNode : public cmGeneratorExpressionNode
 {
   ConfigurationNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 0; }
 
   std::string Evaluate(const std::vector<std::string> &,
@@ -671,6 +718,8 @@ static const struct ConfigurationTestNode : public cmGeneratorExpressionNode
 {
   ConfigurationTestNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return OneOrZeroParameters; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -737,6 +786,8 @@ static const struct JoinNode : public cmGeneratorExpressionNode
 {
   JoinNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return 2; }
 
   virtual bool AcceptsArbitraryContentParameter() const { return true; }
@@ -756,6 +807,8 @@ static const struct CompileLanguageNode : public cmGeneratorExpressionNode
 {
   CompileLanguageNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual int NumExpectedParameters() const { return OneOrZeroParameters; }
 
   std::string Evaluate(const std::vector<std::string> &parameters,
@@ -793,6 +846,8 @@ static const struct CompileLanguageNode : public cmGeneratorExpressionNode
       }
     else if (genName.find("Xcode") != std::string::npos)
       {
+      // The result depends on the property being evaluated.
+      context->Memoizable = false;
       if (dagChecker && (dagChecker->EvaluatingCompileDefinitions()
           || dagChecker->EvaluatingIncludeDirectories()))
         {
@@ -1231,6 +1286,8 @@ static const struct TargetNameNode : public cmGeneratorExpressionNode
 {
   TargetNameNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   virtual bool GeneratesContent() const { return true; }
 
   virtual bool AcceptsArbitraryContentParameter() const { return true; }
@@ -1806,6 +1863,8 @@ static const struct ShellPathNode : public cmGeneratorExpressionNode
 {
   ShellPathNode() {}
 
+  virtual bool IsMemoizable() const { return true; }
+
   std::string Evaluate(const std::vector<std::string> &parameters,
                        cmGeneratorExpressionContext *context,
                        const GeneratorExpressionContent *content,
@@ -41,6 +41,11 @@ struct cmGeneratorExpressionNode
 
   virtual bool RequiresLiteralInput() const { return false; }
 
+  // Whether the result depends only on the parameters and on the local
+  // generator, configuration, language and targets of the context, so
+  // that it may be memoized.
+  virtual bool IsMemoizable() const { return false; }
+
   virtual bool AcceptsArbitraryContentParameter() const
     { return false; }
 
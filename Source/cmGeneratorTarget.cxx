@@ -16,6 +16,7 @@
 #include "cmCustomCommandGenerator.h"
 #include "cmGeneratorExpression.h"
 #include "cmGeneratorExpressionDAGChecker.h"
+#include "cmGeneratedFileStream.h"
 #include "cmGlobalGenerator.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
@@ -147,12 +148,14 @@ struct TagVisitor
   DataType& Data;
   std::vector<cmSourceFile*> BadObjLibFiles;
   cmGeneratorTarget const* Target;
+  std::string const& Config;
   cmGlobalGenerator *GlobalGenerator;
   cmsys::RegularExpression Header;
   bool IsObjLib;
 
-  TagVisitor(cmGeneratorTarget const* target, DataType& data)
-    : Data(data), Target(target),
+  TagVisitor(cmGeneratorTarget const* target, DataType& data,
+             std::string const& config)
+    : Data(data), Target(target), Config(config),
     GlobalGenerator(target->GetLocalGenerator()->GetGlobalGenerator()),
     Header(CM_HEADER_REGEX),
     IsObjLib(target->GetType() == cmState::OBJECT_LIBRARY)
@@ -176,7 +179,8 @@ struct TagVisitor
       {
       DoAccept<IsSameTag<Tag, ExtraSourcesTag>::Result>::Do(this->Data, sf);
       }
-    else if(sf->GetPropertyAsBool("HEADER_FILE_ONLY"))
+    else if(sf->GetPropertyAsBool("HEADER_FILE_ONLY") ||
+            this->Target->IsSourceInUnityBuild(sf, this->Config))
       {
       DoAccept<IsSameTag<Tag, HeaderSourcesTag>::Result>::Do(this->Data, sf);
       }
@@ -573,7 +577,7 @@ static void handleSystemIncludesDep(cmLocalGenerator *lg,
   { \
   std::vector<cmSourceFile*> sourceFiles; \
   this->GetSourceFiles(sourceFiles, config); \
-  TagVisitor< DATA##Tag DATATYPE > visitor(this, data); \
+  TagVisitor< DATA##Tag DATATYPE > visitor(this, data, config); \
   for(std::vector<cmSourceFile*>::const_iterator si = sourceFiles.begin(); \
       si != sourceFiles.end(); ++si) \
     { \
@@ -1187,15 +1191,12 @@ void cmGeneratorTarget::GetSourceFiles(std::vector<cmSourceFile*> &files,
   // Lookup any existing link implementation for this configuration.
   std::string key = cmSystemTools::UpperCase(config);
 
+  SourceFilesMapType::iterator it;
   if(!this->LinkImplementationLanguageIsContextDependent)
     {
     files = this->SourceFilesMap.begin()->second;
-    return;
     }
-
-  SourceFilesMapType::iterator
-    it = this->SourceFilesMap.find(key);
-  if(it != this->SourceFilesMap.end())
+  else if((it = this->SourceFilesMap.find(key)) != this->SourceFilesMap.end())
     {
     files = it->second;
     }
@@ -1217,6 +1218,147 @@ void cmGeneratorTarget::GetSourceFiles(std::vector<cmSourceFile*> &files,
       }
     this->SourceFilesMap[key] = files;
     }
+
+  std::map<std::string, std::vector<cmSourceFile*> >::const_iterator
+    ui = this->UnityFiles.find(key);
+  if(ui != this->UnityFiles.end())
+    {
+    files.insert(files.end(), ui->second.begin(), ui->second.end());
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmGeneratorTarget::IsSourceInUnityBuild(cmSourceFile const* sf,
+                                             const std::string& config) const
+{
+  std::map<std::string, std::set<cmSourceFile const*> >::const_iterator
+    i = this->UnitySources.find(cmSystemTools::UpperCase(config));
+  return i != this->UnitySources.end() && i->second.count(sf);
+}
+
+//----------------------------------------------------------------------------
+void cmGeneratorTarget::AddUnitySources()
+{
+  // Multi-configuration generators may list different sources for each
+  // configuration in a single project, so only single-configuration
+  // generators combine sources.
+  if(this->GetType() > cmState::OBJECT_LIBRARY ||
+     this->IsImported() ||
+     this->LocalGenerator->GetGlobalGenerator()->IsMultiConfig() ||
+     !this->GetPropertyAsBool("UNITY_BUILD"))
+    {
+    return;
+    }
+
+  long batchSize = 8;
+  if(const char* value = this->GetProperty("UNITY_BUILD_BATCH_SIZE"))
+    {
+    if(!cmSystemTools::StringToLong(value, &batchSize) || batchSize < 0)
+      {
+      std::ostringstream e;
+      e << "UNITY_BUILD_BATCH_SIZE property of target \""
+        << this->GetName() << "\" is \"" << value
+        << "\" which is not a non-negative integer.";
+      this->LocalGenerator->IssueMessage(cmake::FATAL_ERROR, e.str());
+      return;
+      }
+    }
+
+  std::vector<std::string> configs;
+  this->Makefile->GetConfigurations(configs);
+  if(configs.empty())
+    {
+    configs.push_back("");
+    }
+  for(std::vector<std::string>::const_iterator ci = configs.begin();
+      ci != configs.end(); ++ci)
+    {
+    std::vector<cmSourceFile*> files;
+    this->GetSourceFiles(files, *ci);
+    this->AddUnitySources(files, *ci, batchSize);
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmGeneratorTarget::AddUnitySources(std::vector<cmSourceFile*>& files,
+                                        const std::string& config,
+                                        long batchSize)
+{
+  // Group the sources that can be compiled together by language in the
+  // order they are listed.  Sources with their own compile flags,
+  // definitions, object dependencies or precompiled header settings and
+  // generated sources are compiled on their own.
+  std::map<std::string, std::vector<cmSourceFile*> > batches;
+  std::vector<std::string> languages;
+  for(std::vector<cmSourceFile*>::const_iterator i = files.begin();
+      i != files.end(); ++i)
+    {
+    cmSourceFile* sf = *i;
+    std::string const& lang = sf->GetLanguage();
+    if((lang != "C" && lang != "CXX") ||
+       sf->GetCustomCommand() ||
+       sf->GetPropertyAsBool("GENERATED") ||
+       sf->GetPropertyAsBool("HEADER_FILE_ONLY") ||
+       sf->GetPropertyAsBool("EXTERNAL_OBJECT") ||
+       sf->GetPropertyAsBool("SKIP_UNITY_BUILD_INCLUSION") ||
+       sf->GetPropertyAsBool("SKIP_PRECOMPILE_HEADERS") ||
+       sf->GetProperty("COMPILE_FLAGS") ||
+       sf->GetProperty("COMPILE_DEFINITIONS") ||
+       sf->GetProperty("OBJECT_DEPENDS"))
+      {
+      continue;
+      }
+    std::vector<cmSourceFile*>& batch = batches[lang];
+    if(batch.empty())
+      {
+      languages.push_back(lang);
+      }
+    batch.push_back(sf);
+    }
+
+  std::string const key = cmSystemTools::UpperCase(config);
+  std::vector<cmSourceFile*>& unityFiles = this->UnityFiles[key];
+  std::set<cmSourceFile const*>& unitySources = this->UnitySources[key];
+  std::string unityDir = this->GetSupportDirectory() + "/Unity";
+  if(!config.empty())
+    {
+    unityDir += "/" + config;
+    }
+  for(std::vector<std::string>::const_iterator li = languages.begin();
+      li != languages.end(); ++li)
+    {
+    std::vector<cmSourceFile*> const& batch = batches[*li];
+    // A single source gains nothing from being included by another.
+    if(batch.size() < 2)
+      {
+      continue;
+      }
+    size_t const size =
+      batchSize ? static_cast<size_t>(batchSize) : batch.size();
+    for(size_t begin = 0, n = 0; begin < batch.size(); begin += size, ++n)
+      {
+      size_t const end = std::min(batch.size(), begin + size);
+      std::ostringstream name;
+      name << unityDir << "/unity_" << n
+           << (*li == "C" ? "_c.c" : "_cxx.cxx");
+      std::string const unityFile = name.str();
+
+      cmGeneratedFileStream fout(unityFile.c_str());
+      fout.SetCopyIfDifferent(true);
+      fout << "/* generated by CMake */\n\n";
+      for(size_t i = begin; i < end; ++i)
+        {
+        fout << "#include \"" << batch[i]->GetFullPath() << "\"\n";
+        unitySources.insert(batch[i]);
+        }
+      fout.Close();
+
+      cmSourceFile* usf = this->Makefile->GetOrCreateSource(unityFile, true);
+      usf->SetProperty("LANGUAGE", li->c_str());
+      usf->GetFullPath();
+      unityFiles.push_back(usf);
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -6096,6 +6238,128 @@ bool cmGeneratorTarget::IsLinkable() const
           this->IsExecutableWithExports());
 }
 
+//----------------------------------------------------------------------------
+cmGeneratorTarget const* cmGeneratorTarget::GetPchReuseTarget() const
+{
+  if(const char* reuseFrom =
+     this->GetProperty("PRECOMPILE_HEADERS_REUSE_FROM"))
+    {
+    if(cmGeneratorTarget const* target =
+       this->LocalGenerator->FindGeneratorTargetToUse(reuseFrom))
+      {
+      return target;
+      }
+    }
+  return this;
+}
+
+//----------------------------------------------------------------------------
+std::string cmGeneratorTarget::GetPchHeader(const std::string& config,
+                                            const std::string& language) const
+{
+  cmGeneratorTarget const* reuseTarget = this->GetPchReuseTarget();
+  if(reuseTarget != this)
+    {
+    return reuseTarget->GetPchHeader(config, language);
+    }
+
+  std::map<std::string, std::string>::const_iterator i =
+    this->PchHeaders.find(cmSystemTools::UpperCase(config) + ":" + language);
+  return i != this->PchHeaders.end() ? i->second : std::string();
+}
+
+//----------------------------------------------------------------------------
+void cmGeneratorTarget::AddPchHeaders()
+{
+  // Only compilers that know how to create and use a precompiled header
+  // are supported.
+  if(this->GetType() > cmState::OBJECT_LIBRARY || this->IsImported())
+    {
+    return;
+    }
+  const char* headers = this->GetProperty("PRECOMPILE_HEADERS");
+  if(!headers || !*headers || this->GetPchReuseTarget() != this)
+    {
+    return;
+    }
+
+  std::vector<std::string> configs;
+  this->Makefile->GetConfigurations(configs);
+  if(configs.empty())
+    {
+    configs.push_back("");
+    }
+  cmGeneratorExpression ge;
+  cmsys::auto_ptr<cmCompiledGeneratorExpression> cge = ge.Parse(headers);
+  for(std::vector<std::string>::const_iterator ci = configs.begin();
+      ci != configs.end(); ++ci)
+    {
+    std::set<std::string> languages;
+    this->GetLanguages(languages, *ci);
+    for(std::set<std::string>::const_iterator li = languages.begin();
+        li != languages.end(); ++li)
+      {
+      if(!this->Makefile->GetDefinition(
+           "CMAKE_" + *li + "_COMPILE_OPTIONS_CREATE_PCH") ||
+         !this->Makefile->GetDefinition(
+           "CMAKE_" + *li + "_COMPILE_OPTIONS_USE_PCH"))
+        {
+        continue;
+        }
+      std::vector<std::string> entries;
+      cmSystemTools::ExpandListArgument(
+        cge->Evaluate(this->LocalGenerator, *ci, false, this, 0, 0, *li),
+        entries);
+      if(entries.empty())
+        {
+        continue;
+        }
+
+      std::string pchHeader = this->GetSupportDirectory();
+      if(configs.size() > 1)
+        {
+        pchHeader += "/" + *ci;
+        }
+      pchHeader += *li == "C" ? "/cmake_pch.h" : "/cmake_pch.hxx";
+
+      // Headers named in angle brackets are found in the include path and
+      // all others relative to the source directory of the target.
+      cmGeneratedFileStream fout(pchHeader.c_str());
+      fout.SetCopyIfDifferent(true);
+      fout << "/* generated by CMake */\n\n";
+      for(std::vector<std::string>::const_iterator e = entries.begin();
+          e != entries.end(); ++e)
+        {
+        if((*e)[0] == '<' && (*e)[e->size()-1] == '>')
+          {
+          fout << "#include " << *e << "\n";
+          }
+        else
+          {
+          fout << "#include \"" << cmSystemTools::CollapseFullPath(
+            *e, this->LocalGenerator->GetCurrentSourceDirectory()) << "\"\n";
+          }
+        }
+      fout.Close();
+      this->PchHeaders[cmSystemTools::UpperCase(*ci) + ":" + *li] = pchHeader;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+std::string cmGeneratorTarget::GetPchFile(const std::string& config,
+                                          const std::string& language) const
+{
+  cmGeneratorTarget const* reuseTarget = this->GetPchReuseTarget();
+  std::string pchFile = reuseTarget->GetPchHeader(config, language);
+  if(!pchFile.empty())
+    {
+    pchFile += reuseTarget->Makefile->GetSafeDefinition(
+      "CMAKE_" + language + "_PCH_EXTENSION");
+    }
+  return pchFile;
+}
+
 //----------------------------------------------------------------------------
 bool cmGeneratorTarget::IsFrameworkOnApple() const
 {
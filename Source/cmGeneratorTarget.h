@@ -66,6 +66,15 @@ public:
 
   void GetObjectSources(std::vector<cmSourceFile const*> &,
                         const std::string& config) const;
+
+  /** Write the unity sources of this target for each configuration.
+      GetSourceFiles lists them from then on.  */
+  void AddUnitySources();
+
+  /** Return whether the source is compiled as part of a generated unity
+      source of this target instead of on its own.  */
+  bool IsSourceInUnityBuild(cmSourceFile const* sf,
+                            const std::string& config) const;
   const std::string& GetObjectName(cmSourceFile const* file);
 
   bool HasExplicitObjectName(cmSourceFile const* file) const;
@@ -452,6 +461,25 @@ public:
   /** Get a build-tree directory in which to place target support files.  */
   std::string GetSupportDirectory() const;
 
+  /** Get the target whose precompiled headers this target uses.  This
+      is the target named by PRECOMPILE_HEADERS_REUSE_FROM, if any, or
+      this target itself.  */
+  cmGeneratorTarget const* GetPchReuseTarget() const;
+
+  /** Get the generated header including the PRECOMPILE_HEADERS used for
+      sources of the given language, or an empty string if there is
+      none or the compiler cannot precompile headers.  */
+  std::string GetPchHeader(const std::string& config,
+                           const std::string& language) const;
+
+  /** Write the headers returned by GetPchHeader for each configuration
+      and language compiled by this target.  */
+  void AddPchHeaders();
+
+  /** Get the precompiled header built from GetPchHeader.  */
+  std::string GetPchFile(const std::string& config,
+                         const std::string& language) const;
+
   /** Return whether this target may be used to link another target.  */
   bool IsLinkable() const;
 
@@ -522,6 +550,7 @@ private:
   mutable std::map<cmSourceFile const*, std::string> Objects;
   std::set<cmSourceFile const*> ExplicitObjectName;
   mutable std::map<std::string, std::vector<std::string> > SystemIncludesCache;
+  std::map<std::string, std::string> PchHeaders;
 
   mutable std::string ExportMacro;
 
@@ -646,6 +675,10 @@ private:
 
   void GetSourceFiles(std::vector<std::string>& files,
                       const std::string& config) const;
+  void AddUnitySources(std::vector<cmSourceFile*>& files,
+                       const std::string& config, long batchSize);
+  std::map<std::string, std::vector<cmSourceFile*> > UnityFiles;
+  std::map<std::string, std::set<cmSourceFile const*> > UnitySources;
 
   struct HeadToLinkImplementationMap:
     public std::map<cmGeneratorTarget const*, cmOptionalLinkImplementation> {};
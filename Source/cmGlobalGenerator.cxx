@@ -33,6 +33,8 @@
 #include "cmSourceFile.h"
 #include "cmState.h"
 #include "cmTargetExport.h"
+#include "cmTest.h"
+#include "cmTestGenerator.h"
 #include "cmVersion.h"
 #include "cmake.h"
 
@@ -40,6 +42,7 @@
 #include <cmsys/FStream.hxx>
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmGenerateProfile.h"
 # include "cm_jsoncpp_value.h"
 # include "cm_jsoncpp_writer.h"
 # include <cmsys/MD5.h>
@@ -1146,6 +1149,9 @@ void cmGlobalGenerator::CreateLocalGenerators()
 {
   cmDeleteAll(this->LocalGenerators);
   this->LocalGenerators.clear();
+
+  cmDeleteAll(this->DependentGeneratorExpressions);
+  this->DependentGeneratorExpressions.clear();
   this->LocalGenerators.reserve(this->Makefiles.size());
   for (std::vector<cmMakefile*>::const_iterator it = this->Makefiles.begin();
        it != this->Makefiles.end(); ++it)
@@ -1355,6 +1361,30 @@ bool cmGlobalGenerator::Compute()
     }
 #endif
 
+  // Combine the sources of unity builds now that no more are added.
+  for (i = 0; i < this->LocalGenerators.size(); ++i)
+    {
+    std::vector<cmGeneratorTarget*> targets =
+      this->LocalGenerators[i]->GetGeneratorTargets();
+    for(std::vector<cmGeneratorTarget*>::iterator ti = targets.begin();
+        ti != targets.end(); ++ti)
+      {
+      (*ti)->AddUnitySources();
+      }
+    }
+
+  // Write the precompiled headers for the final sources of each target.
+  for (i = 0; i < this->LocalGenerators.size(); ++i)
+    {
+    std::vector<cmGeneratorTarget*> targets =
+      this->LocalGenerators[i]->GetGeneratorTargets();
+    for(std::vector<cmGeneratorTarget*>::iterator ti = targets.begin();
+        ti != targets.end(); ++ti)
+      {
+      (*ti)->AddPchHeaders();
+      }
+    }
+
   for (i = 0; i < this->LocalGenerators.size(); ++i)
     {
     cmMakefile* mf = this->LocalGenerators[i]->GetMakefile();
@@ -1384,10 +1414,16 @@ bool cmGlobalGenerator::Compute()
     }
 
   // Compute the inter-target dependencies.
+  {
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  cmGenerateProfile::Scope profileScope(
+    this->CMakeInstance->GetGenerateProfile(), "ComputeTargetDepends");
+#endif
   if(!this->ComputeTargetDepends())
     {
     return false;
     }
+  }
 
   for (i = 0; i < this->LocalGenerators.size(); ++i)
     {
@@ -1409,7 +1445,14 @@ void cmGlobalGenerator::Generate()
   for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i)
     {
     this->SetCurrentMakefile(this->LocalGenerators[i]->GetMakefile());
+    {
+#ifdef CMAKE_BUILD_WITH_CMAKE
+    cmGenerateProfile::Scope profileScope(
+      this->CMakeInstance->GetGenerateProfile(), "LocalGenerator::Generate",
+      this->LocalGenerators[i]->GetCurrentBinaryDirectory());
+#endif
     this->LocalGenerators[i]->Generate();
+    }
     if(!this->LocalGenerators[i]->GetMakefile()->IsOn(
       "CMAKE_SKIP_INSTALL_RULES"))
       {
@@ -1444,6 +1487,7 @@ void cmGlobalGenerator::Generate()
   this->CheckRuleHashes();
 
   this->WriteSummary();
+  this->WriteTestImpactFile();
 
   if (this->ExtraGenerator != 0)
     {
@@ -1493,6 +1537,9 @@ cmGlobalGenerator::CreateQtAutoGeneratorsTargets()
   std::vector<const cmGeneratorTarget*> autogenTargets;
 
 #ifdef CMAKE_BUILD_WITH_CMAKE
+  cmGenerateProfile::Scope profileScope(
+    this->CMakeInstance->GetGenerateProfile(),
+    "CreateQtAutoGeneratorsTargets");
   for(unsigned int i=0; i < this->LocalGenerators.size(); ++i)
     {
     std::vector<cmGeneratorTarget*> targets =
@@ -1553,6 +1600,10 @@ cmGlobalGenerator::CreateQtAutoGeneratorsTargets()
 //----------------------------------------------------------------------------
 void cmGlobalGenerator::FinalizeTargetCompileInfo()
 {
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  cmGenerateProfile::Scope profileScope(
+    this->CMakeInstance->GetGenerateProfile(), "FinalizeTargetCompileInfo");
+#endif
   // Construct per-target generator information.
   for(unsigned int i=0; i < this->Makefiles.size(); ++i)
     {
@@ -1676,6 +1727,9 @@ void cmGlobalGenerator::ClearGeneratorMembers()
   cmDeleteAll(this->LocalGenerators);
   this->LocalGenerators.clear();
 
+  cmDeleteAll(this->DependentGeneratorExpressions);
+  this->DependentGeneratorExpressions.clear();
+
   this->ExportSets.clear();
   this->TargetDependencies.clear();
   this->TargetSearchIndex.clear();
@@ -2989,6 +3043,10 @@ void cmGlobalGenerator::WriteRuleHashes(std::string const& pfile)
 //----------------------------------------------------------------------------
 void cmGlobalGenerator::WriteSummary()
 {
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  cmGenerateProfile::Scope profileScope(
+    this->CMakeInstance->GetGenerateProfile(), "WriteSummary");
+#endif
   // Record all target directories in a central location.
   std::string fname = this->CMakeInstance->GetHomeOutputDirectory();
   fname += cmake::GetCMakeFilesDirectory();
@@ -3012,6 +3070,140 @@ void cmGlobalGenerator::WriteSummary()
     }
 }
 
+//----------------------------------------------------------------------------
+void cmGlobalGenerator::WriteTestImpactFile()
+{
+#ifdef CMAKE_BUILD_WITH_CMAKE
+  // Tell ctest which sources each test depends on so that it can run
+  // only the tests affected by a change.
+  bool testingEnabled = false;
+  cmGenerateProfile::Scope profileScope(
+    this->CMakeInstance->GetGenerateProfile(), "WriteTestImpactFile");
+
+  Json::Value root(Json::objectValue);
+  root["sourceDir"] = this->CMakeInstance->GetHomeDirectory();
+  Json::Value& targets = root["targets"] = Json::objectValue;
+  Json::Value& tests = root["tests"] = Json::arrayValue;
+  for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i)
+    {
+    cmLocalGenerator* lg = this->LocalGenerators[i];
+    cmMakefile* mf = lg->GetMakefile();
+    std::vector<std::string> configs;
+    mf->GetConfigurations(configs);
+    if (configs.empty())
+      {
+      configs.push_back("");
+      }
+
+    std::vector<cmGeneratorTarget*> tgts = lg->GetGeneratorTargets();
+    for (std::vector<cmGeneratorTarget*>::iterator it = tgts.begin();
+         it != tgts.end(); ++it)
+      {
+      cmGeneratorTarget* gt = *it;
+      if (gt->GetType() == cmState::INTERFACE_LIBRARY)
+        {
+        continue;
+        }
+      std::set<std::string> sources;
+      for (std::vector<std::string>::const_iterator ci = configs.begin();
+           ci != configs.end(); ++ci)
+        {
+        std::vector<cmSourceFile*> files;
+        gt->GetSourceFiles(files, *ci);
+        for (std::vector<cmSourceFile*>::const_iterator si = files.begin();
+             si != files.end(); ++si)
+          {
+          sources.insert((*si)->GetFullPath());
+          }
+        }
+      Json::Value& target = targets[gt->GetName()] = Json::objectValue;
+      Json::Value& jsources = target["sources"] = Json::arrayValue;
+      for (std::set<std::string>::const_iterator si = sources.begin();
+           si != sources.end(); ++si)
+        {
+        jsources.append(*si);
+        }
+      // Sort the dependencies by name for a stable file content.
+      std::set<std::string> dependNames;
+      TargetDependSet const& depends = this->GetTargetDirectDepends(gt);
+      for (TargetDependSet::const_iterator di = depends.begin();
+           di != depends.end(); ++di)
+        {
+        dependNames.insert((*di)->GetName());
+        }
+      Json::Value& jdepends = target["dependencies"] = Json::arrayValue;
+      for (std::set<std::string>::const_iterator di = dependNames.begin();
+           di != dependNames.end(); ++di)
+        {
+        jdepends.append(*di);
+        }
+      }
+
+    // Only directories with testing enabled have test files.
+    if (!mf->IsOn("CMAKE_TESTING_ENABLED"))
+      {
+      continue;
+      }
+    testingEnabled = true;
+    std::vector<cmTestGenerator*> const& testGenerators =
+      mf->GetTestGenerators();
+    for (std::vector<cmTestGenerator*>::const_iterator ti =
+           testGenerators.begin(); ti != testGenerators.end(); ++ti)
+      {
+      cmTest* test = (*ti)->GetTest();
+      std::vector<std::string> const& command = test->GetCommand();
+      std::set<std::string> used;
+      if (!command.empty())
+        {
+        cmGeneratorTarget* gt = lg->FindGeneratorTargetToUse(command[0]);
+        if (gt && gt->GetType() == cmState::EXECUTABLE)
+          {
+          used.insert(gt->GetName());
+          }
+        }
+      // Targets named in generator expressions such as $<TARGET_FILE:>.
+      if (!test->GetOldStyle())
+        {
+        cmGeneratorExpression ge(test->GetBacktrace());
+        for (std::vector<std::string>::const_iterator ai = command.begin();
+             ai != command.end(); ++ai)
+          {
+          cmsys::auto_ptr<cmCompiledGeneratorExpression> cge =
+            ge.Parse(*ai);
+          cge->Evaluate(lg, configs[0], true);
+          std::set<cmGeneratorTarget*> const& found = cge->GetTargets();
+          for (std::set<cmGeneratorTarget*>::const_iterator fi =
+                 found.begin(); fi != found.end(); ++fi)
+            {
+            used.insert((*fi)->GetName());
+            }
+          }
+        }
+      Json::Value& jtest = tests.append(Json::objectValue);
+      jtest["name"] = test->GetName();
+      jtest["directory"] = lg->GetCurrentBinaryDirectory();
+      Json::Value& jtargets = jtest["targets"] = Json::arrayValue;
+      for (std::set<std::string>::const_iterator ui = used.begin();
+           ui != used.end(); ++ui)
+        {
+        jtargets.append(*ui);
+        }
+      }
+    }
+
+  if (!testingEnabled)
+    {
+    return;
+    }
+  std::string fname = this->CMakeInstance->GetHomeOutputDirectory();
+  fname += cmake::GetCMakeFilesDirectory();
+  fname += "/TestImpact.json";
+  cmGeneratedFileStream fout(fname.c_str());
+  fout.SetCopyIfDifferent(true);
+  fout << root;
+#endif
+}
+
 //----------------------------------------------------------------------------
 void cmGlobalGenerator::WriteSummary(cmGeneratorTarget* target)
 {
@@ -3127,6 +3319,24 @@ cmGlobalGenerator::GetFilenameTargetDepends(cmSourceFile* sf) const {
   return this->FilenameTargetDepends[sf];
 }
 
+//----------------------------------------------------------------------------
+cmCompiledGeneratorExpression const&
+cmGlobalGenerator::GetDependentGeneratorExpression(
+                                        std::string const& input) const
+{
+  std::map<std::string, cmCompiledGeneratorExpression*>::iterator i =
+    this->DependentGeneratorExpressions.find(input);
+  if (i == this->DependentGeneratorExpressions.end())
+    {
+    // Errors are reported with the backtrace of the evaluation context
+    // so the expression does not need one of its own.
+    cmGeneratorExpression ge;
+    i = this->DependentGeneratorExpressions.insert(
+      std::make_pair(input, ge.Parse(input).release())).first;
+    }
+  return *i->second;
+}
+
 //----------------------------------------------------------------------------
 void cmGlobalGenerator::CreateEvaluationSourceFiles(
                                               std::string const& config) const
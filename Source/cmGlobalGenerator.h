@@ -351,6 +351,12 @@ public:
   const std::set<const cmGeneratorTarget*>&
   GetFilenameTargetDepends(cmSourceFile* sf) const;
 
+  /** Get the compiled form of a generator expression found in a target
+      property.  It is shared by all evaluations during generation so
+      that its memoized results are reused across consumers.  */
+  cmCompiledGeneratorExpression const&
+  GetDependentGeneratorExpression(std::string const& input) const;
+
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   cmFileLockPool& GetFileLockPool() { return FileLockPool; }
 #endif
@@ -468,6 +474,7 @@ private:
 
   void WriteSummary();
   void WriteSummary(cmGeneratorTarget* target);
+  void WriteTestImpactFile();
   void FinalizeTargetCompileInfo();
 
   virtual void ForceLinkerLanguages();
@@ -519,6 +526,9 @@ private:
   mutable std::map<cmSourceFile*, std::set<cmGeneratorTarget const*> >
   FilenameTargetDepends;
 
+  mutable std::map<std::string, cmCompiledGeneratorExpression*>
+  DependentGeneratorExpressions;
+
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   // Pool of file locks
   cmFileLockPool FileLockPool;
@@ -13,12 +13,17 @@
 #include "cmGlobalNinjaGenerator.h"
 
 #include "cmAlgorithms.h"
+#include "cmFortranParser.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpressionEvaluationFile.h"
 #include "cmGeneratorTarget.h"
 #include "cmLocalNinjaGenerator.h"
 #include "cmMakefile.h"
+#include "cmSourceFile.h"
 #include "cmVersion.h"
+#include "cmake.h"
+
+#include <cmsys/FStream.hxx>
 
 #include <algorithm>
 #include <assert.h>
@@ -521,6 +526,7 @@ cmGlobalNinjaGenerator::cmGlobalNinjaGenerator(cmake* cm)
   , UsingGCCOnWindows(false)
   , ComputingUnknownDependencies(false)
   , PolicyCMP0058(cmPolicies::WARN)
+  , FortranSourcesComputed(false)
 {
 #ifdef _WIN32
   cm->GetState()->SetWindowsShell(true);
@@ -578,6 +584,7 @@ void cmGlobalNinjaGenerator::Generate()
   this->cmGlobalGenerator::Generate();
 
   this->WriteAssumedSourceDependencies();
+  this->WriteFortranModuleScan(*this->BuildFileStream);
   this->WriteTargetAliases(*this->BuildFileStream);
   this->WriteFolderTargets(*this->BuildFileStream);
   this->WriteUnknownExplicitDependencies(*this->BuildFileStream);
@@ -615,10 +622,6 @@ void cmGlobalNinjaGenerator
                  cmMakefile* mf,
                  bool optional)
 {
-  if (std::find(langs.begin(), langs.end(), "Fortran") != langs.end())
-    {
-    cmSystemTools::Error("The Ninja generator does not support Fortran yet.");
-    }
   this->cmGlobalGenerator::EnableLanguage(langs, mf, optional);
   for(std::vector<std::string>::const_iterator l = langs.begin();
       l != langs.end(); ++l)
@@ -947,6 +950,390 @@ void cmGlobalNinjaGenerator::WriteAssumedSourceDependencies()
   }
 }
 
+//----------------------------------------------------------------------------
+void cmGlobalNinjaGenerator::ComputeFortranSources()
+{
+  this->FortranSourcesComputed = true;
+  for(std::vector<cmLocalGenerator*>::const_iterator
+        lgi = this->LocalGenerators.begin();
+      lgi != this->LocalGenerators.end(); ++lgi)
+    {
+    cmLocalGenerator* lg = *lgi;
+    std::string const config =
+      lg->GetMakefile()->GetSafeDefinition("CMAKE_BUILD_TYPE");
+    std::string const configDefs =
+      "COMPILE_DEFINITIONS_" + cmSystemTools::UpperCase(config);
+
+    // Objects are named the way cmNinjaTargetGenerator names them.
+    std::string homeRelative =
+      lg->Convert(lg->GetCurrentBinaryDirectory(),
+                  cmOutputConverter::HOME_OUTPUT);
+    if(homeRelative == ".")
+      {
+      homeRelative = "";
+      }
+
+    std::vector<cmGeneratorTarget*> const& targets =
+      lg->GetGeneratorTargets();
+    for(std::vector<cmGeneratorTarget*>::const_iterator ti = targets.begin();
+        ti != targets.end(); ++ti)
+      {
+      cmGeneratorTarget* gt = *ti;
+      if(gt->GetType() == cmState::INTERFACE_LIBRARY)
+        {
+        continue;
+        }
+      std::vector<cmSourceFile const*> objectSources;
+      gt->GetObjectSources(objectSources, config);
+
+      std::vector<std::string> includeDirs;
+      std::vector<std::string> targetDefines;
+      bool haveFlags = false;
+      for(std::vector<cmSourceFile const*>::const_iterator
+            si = objectSources.begin(); si != objectSources.end(); ++si)
+        {
+        cmSourceFile const* sf = *si;
+        if(sf->GetLanguage() != "Fortran")
+          {
+          continue;
+          }
+        if(!haveFlags)
+          {
+          lg->GetIncludeDirectories(includeDirs, gt, "Fortran", config);
+          gt->GetCompileDefinitions(targetDefines, config, "Fortran");
+          haveFlags = true;
+          }
+
+        FortranSource fs;
+        fs.Source = sf->GetFullPath();
+        fs.Object = homeRelative;
+        if(!fs.Object.empty())
+          {
+          fs.Object += "/";
+          }
+        fs.Object += lg->GetTargetDirectory(gt);
+        fs.Object += "/";
+        fs.Object += gt->GetObjectName(sf);
+        fs.Generated = sf->GetPropertyAsBool("GENERATED");
+        fs.IncludeDirs = includeDirs;
+
+        // The scanner only needs the names of defined symbols.
+        std::vector<std::string> defines = targetDefines;
+        if(const char* defs = sf->GetProperty("COMPILE_DEFINITIONS"))
+          {
+          cmSystemTools::ExpandListArgument(defs, defines);
+          }
+        if(const char* defs = sf->GetProperty(configDefs))
+          {
+          cmSystemTools::ExpandListArgument(defs, defines);
+          }
+        for(std::vector<std::string>::const_iterator di = defines.begin();
+            di != defines.end(); ++di)
+          {
+          fs.Defines.insert(di->substr(0, di->find('=')));
+          }
+
+        ScanFortranSource(fs);
+
+        size_t index = this->FortranSources.size();
+        this->FortranSourceIndex[std::make_pair(gt, sf)] = index;
+        for(std::set<std::string>::const_iterator
+              pi = fs.Provides.begin(); pi != fs.Provides.end(); ++pi)
+          {
+          this->FortranModuleProviders[*pi].push_back(index);
+          }
+        this->FortranSources.push_back(fs);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmGlobalNinjaGenerator::AppendFortranObjectDepends(
+  cmGeneratorTarget* target, cmSourceFile const* source, cmNinjaDeps& deps)
+{
+  if(!this->FortranSourcesComputed)
+    {
+    this->ComputeFortranSources();
+    }
+  std::map<std::pair<cmGeneratorTarget const*, cmSourceFile const*>,
+           size_t>::const_iterator i =
+    this->FortranSourceIndex.find(std::make_pair(target, source));
+  if(i == this->FortranSourceIndex.end())
+    {
+    return;
+    }
+  FortranSource const& fs = this->FortranSources[i->second];
+
+  // Compile the providers of used modules first.  Modules the project
+  // does not provide come with the compiler or an external package.
+  std::set<std::string> objects;
+  for(std::set<std::string>::const_iterator ri = fs.Requires.begin();
+      ri != fs.Requires.end(); ++ri)
+    {
+    std::map<std::string, std::vector<size_t> >::const_iterator p =
+      this->FortranModuleProviders.find(*ri);
+    if(p == this->FortranModuleProviders.end())
+      {
+      continue;
+      }
+    for(std::vector<size_t>::const_iterator pi = p->second.begin();
+        pi != p->second.end(); ++pi)
+      {
+      if(this->FortranSources[*pi].Object != fs.Object)
+        {
+        objects.insert(this->FortranSources[*pi].Object);
+        }
+      }
+    }
+  deps.insert(deps.end(), objects.begin(), objects.end());
+
+  // The compiler does not report included files, so use what the
+  // scanner found.
+  for(std::set<std::string>::const_iterator ii = fs.Includes.begin();
+      ii != fs.Includes.end(); ++ii)
+    {
+    deps.push_back(this->ConvertToNinjaPath(*ii));
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmGlobalNinjaGenerator::ScanFortranSource(FortranSource& fs)
+{
+  cmFortranSourceInfo info;
+  cmFortranParser parser(fs.IncludeDirs, fs.Defines, info);
+
+  // A generated source may not exist yet.  It is scanned again once
+  // it does.
+  if(!cmFortranParser_FilePush(&parser, fs.Source.c_str()))
+    {
+    return;
+    }
+  cmFortran_yyparse(parser.Scanner);
+  fs.Provides = info.Provides;
+  fs.Includes = info.Includes;
+
+  // A source may use modules it provides itself.
+  for(std::set<std::string>::const_iterator ri = info.Requires.begin();
+      ri != info.Requires.end(); ++ri)
+    {
+    if(fs.Provides.find(*ri) == fs.Provides.end())
+      {
+      fs.Requires.insert(*ri);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmGlobalNinjaGenerator::WriteFortranScanInfo(
+  std::ostream& os, FortranSourceVector const& sources)
+{
+  os << "# Fortran sources to scan for modules, generated by CMake.\n";
+  for(FortranSourceVector::const_iterator fi = sources.begin();
+      fi != sources.end(); ++fi)
+    {
+    os << "source " << fi->Source << "\n";
+    for(std::vector<std::string>::const_iterator
+          ii = fi->IncludeDirs.begin(); ii != fi->IncludeDirs.end(); ++ii)
+      {
+      os << "include " << *ii << "\n";
+      }
+    for(std::set<std::string>::const_iterator
+          di = fi->Defines.begin(); di != fi->Defines.end(); ++di)
+      {
+      os << "define " << *di << "\n";
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmGlobalNinjaGenerator::ReadFortranScanInfo(
+  std::string const& fname, FortranSourceVector& sources)
+{
+  cmsys::ifstream fin(fname.c_str());
+  if(!fin)
+    {
+    cmSystemTools::Error("Cannot read Fortran scan information from ",
+                         fname.c_str());
+    return false;
+    }
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    std::string::size_type space = line.find(' ');
+    if(line.empty() || line[0] == '#' || space == std::string::npos)
+      {
+      continue;
+      }
+    std::string const key = line.substr(0, space);
+    std::string const value = line.substr(space + 1);
+    if(key == "source")
+      {
+      FortranSource fs;
+      fs.Source = value;
+      fs.Generated = false;
+      sources.push_back(fs);
+      }
+    else if(sources.empty())
+      {
+      continue;
+      }
+    else if(key == "include")
+      {
+      sources.back().IncludeDirs.push_back(value);
+      }
+    else if(key == "define")
+      {
+      sources.back().Defines.insert(value);
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool cmGlobalNinjaGenerator::WriteFortranModuleMap(
+  std::string const& fname, FortranSourceVector const& sources)
+{
+  // Leave the map untouched when nothing changed so that the build
+  // manifest is not regenerated.
+  cmGeneratedFileStream fout(fname.c_str());
+  fout.SetCopyIfDifferent(true);
+  fout << "# Fortran module map, generated by CMake.\n";
+  for(FortranSourceVector::const_iterator fi = sources.begin();
+      fi != sources.end(); ++fi)
+    {
+    fout << fi->Source << "\n";
+    for(std::set<std::string>::const_iterator
+          pi = fi->Provides.begin(); pi != fi->Provides.end(); ++pi)
+      {
+      fout << "  provides " << *pi << "\n";
+      }
+    for(std::set<std::string>::const_iterator
+          ri = fi->Requires.begin(); ri != fi->Requires.end(); ++ri)
+      {
+      fout << "  requires " << *ri << "\n";
+      }
+    for(std::set<std::string>::const_iterator
+          ii = fi->Includes.begin(); ii != fi->Includes.end(); ++ii)
+      {
+      fout << "  includes " << *ii << "\n";
+      }
+    }
+  if(!fout)
+    {
+    return false;
+    }
+  fout.Close();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool cmGlobalNinjaGenerator::ScanFortranModules(std::string const& infoFile,
+                                                std::string const& mapFile)
+{
+  FortranSourceVector sources;
+  if(!ReadFortranScanInfo(infoFile, sources))
+    {
+    return false;
+    }
+  for(FortranSourceVector::iterator fi = sources.begin();
+      fi != sources.end(); ++fi)
+    {
+    ScanFortranSource(*fi);
+    }
+  return WriteFortranModuleMap(mapFile, sources);
+}
+
+//----------------------------------------------------------------------------
+void cmGlobalNinjaGenerator::WriteFortranModuleScan(std::ostream& os)
+{
+  if(this->FortranSources.empty())
+    {
+    return;
+    }
+
+  // The module dependencies between objects are fixed in the build
+  // manifest.  Scan the sources again whenever one of them changes and
+  // regenerate the manifest when the modules they provide or use, or
+  // the files they include, are no longer the same.
+  std::string const filesDir =
+    std::string(this->GetCMakeInstance()->GetHomeOutputDirectory()) +
+    cmake::GetCMakeFilesDirectory();
+  std::string const infoFile = filesDir + "/FortranScanInfo.txt";
+  std::string const mapFile = filesDir + "/FortranModules.txt";
+  {
+  cmGeneratedFileStream fout(infoFile.c_str());
+  fout.SetCopyIfDifferent(true);
+  WriteFortranScanInfo(fout, this->FortranSources);
+  }
+  WriteFortranModuleMap(mapFile, this->FortranSources);
+
+  cmLocalGenerator* lg = this->LocalGenerators[0];
+  std::ostringstream cmd;
+  cmd << lg->ConvertToOutputFormat(cmSystemTools::GetCMakeCommand(),
+                                   cmOutputConverter::SHELL)
+      << " -E cmake_ninja_fortran_scan "
+      << lg->ConvertToOutputFormat(this->ConvertToNinjaPath(infoFile),
+                                   cmOutputConverter::SHELL)
+      << " $out";
+  this->AddRule("FORTRAN_MODULE_SCAN",
+                cmd.str(),
+                "Scanning Fortran sources for modules",
+                "Rule for scanning Fortran sources for modules.",
+                /*depfile=*/ "",
+                /*deptype=*/ "",
+                /*rspfile=*/ "",
+                /*rspcontent*/ "",
+                /*restat=*/ "1",
+                /*generator=*/ false);
+
+  // Sources that are generated during the build are scanned after they
+  // are generated, and again whenever they are regenerated.
+  std::set<std::string> sources;
+  std::set<std::string> generated;
+  std::set<std::string> includes;
+  for(FortranSourceVector::const_iterator fi = this->FortranSources.begin();
+      fi != this->FortranSources.end(); ++fi)
+    {
+    if(fi->Generated)
+      {
+      generated.insert(this->ConvertToNinjaPath(fi->Source));
+      }
+    else
+      {
+      sources.insert(this->ConvertToNinjaPath(fi->Source));
+      }
+    for(std::set<std::string>::const_iterator ii = fi->Includes.begin();
+        ii != fi->Includes.end(); ++ii)
+      {
+      std::string const inc = this->ConvertToNinjaPath(*ii);
+      if(!this->HasCustomCommandOutput(inc))
+        {
+        includes.insert(inc);
+        }
+      }
+    }
+  cmNinjaDeps explicitDeps(sources.begin(), sources.end());
+  cmNinjaDeps includeDeps(includes.begin(), includes.end());
+  cmNinjaDeps implicitDeps = includeDeps;
+  implicitDeps.insert(implicitDeps.end(), generated.begin(), generated.end());
+  this->WriteBuild(os,
+                   "Scan Fortran sources for module dependencies.",
+                   "FORTRAN_MODULE_SCAN",
+                   cmNinjaDeps(1, this->ConvertToNinjaPath(mapFile)),
+                   explicitDeps,
+                   implicitDeps,
+                   cmNinjaDeps(),
+                   cmNinjaVars());
+  if(!includeDeps.empty())
+    {
+    this->WritePhonyBuild(os,
+                          "A missing Fortran include file is not an error.",
+                          includeDeps,
+                          cmNinjaDeps());
+    }
+}
+
 void
 cmGlobalNinjaGenerator
 ::AppendTargetOutputs(cmGeneratorTarget const* target, cmNinjaDeps& outputs)
@@ -1350,12 +1737,21 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
     variables["pool"] = "console";
     }
 
+  // The Fortran module map is rewritten when module dependencies change.
+  cmNinjaDeps manifestDeps = implicitDeps;
+  if(!this->FortranSources.empty())
+    {
+    manifestDeps.push_back(this->ConvertToNinjaPath(
+      std::string(this->GetCMakeInstance()->GetHomeOutputDirectory()) +
+      cmake::GetCMakeFilesDirectory() + "/FortranModules.txt"));
+    }
+
   this->WriteBuild(os,
                    "Re-run CMake if any of its inputs changed.",
                    "RERUN_CMAKE",
                    /*outputs=*/ cmNinjaDeps(1, NINJA_BUILD_FILE),
                    /*explicitDeps=*/ cmNinjaDeps(),
-                   implicitDeps,
+                   manifestDeps,
                    /*orderOnlyDeps=*/ cmNinjaDeps(),
                    variables);
 
@@ -23,6 +23,7 @@
 class cmLocalGenerator;
 class cmGeneratedFileStream;
 class cmGeneratorTarget;
+class cmSourceFile;
 
 /**
  * \class cmGlobalNinjaGenerator
@@ -315,6 +316,18 @@ public:
 
   virtual void ComputeTargetObjectDirectory(cmGeneratorTarget* gt) const;
 
+  /// Append to deps the objects that provide Fortran modules used by the
+  /// given Fortran source of the target and the files it includes.
+  void AppendFortranObjectDepends(cmGeneratorTarget* target,
+                                  cmSourceFile const* source,
+                                  cmNinjaDeps& deps);
+
+  /// Scan the Fortran sources listed in an info file written by the
+  /// generator and write their module map if it changed.  This is the
+  /// implementation of "cmake -E cmake_ninja_fortran_scan".
+  static bool ScanFortranModules(std::string const& infoFile,
+                                 std::string const& mapFile);
+
   // Ninja generator uses 'deps' and 'msvc_deps_prefix' introduced in 1.3
   static std::string RequiredNinjaVersion() { return "1.3"; }
   static std::string RequiredNinjaVersionForConsolePool() { return "1.5"; }
@@ -344,6 +357,31 @@ private:
 
   void WriteAssumedSourceDependencies();
 
+  /// A Fortran source compiled by some target, with what the module
+  /// scanner found in it.
+  struct FortranSource
+  {
+    std::string Source;
+    std::string Object;
+    bool Generated;
+    std::vector<std::string> IncludeDirs;
+    std::set<std::string> Defines;
+    std::set<std::string> Provides;
+    std::set<std::string> Requires;
+    std::set<std::string> Includes;
+  };
+  typedef std::vector<FortranSource> FortranSourceVector;
+
+  void ComputeFortranSources();
+  void WriteFortranModuleScan(std::ostream& os);
+  static void ScanFortranSource(FortranSource& fs);
+  static void WriteFortranScanInfo(std::ostream& os,
+                                   FortranSourceVector const& sources);
+  static bool ReadFortranScanInfo(std::string const& fname,
+                                  FortranSourceVector& sources);
+  static bool WriteFortranModuleMap(std::string const& fname,
+                                    FortranSourceVector const& sources);
+
   void WriteTargetAliases(std::ostream& os);
   void WriteFolderTargets(std::ostream& os);
   void WriteUnknownExplicitDependencies(std::ostream& os);
@@ -400,6 +438,14 @@ private:
   /// The mapping from source file to assumed dependencies.
   std::map<std::string, std::set<std::string> > AssumedSourceDependencies;
 
+  /// The Fortran sources of all targets, scanned for modules the first
+  /// time a target asks for the dependencies of one of them.
+  bool FortranSourcesComputed;
+  FortranSourceVector FortranSources;
+  std::map<std::pair<cmGeneratorTarget const*, cmSourceFile const*>,
+           size_t> FortranSourceIndex;
+  std::map<std::string, std::vector<size_t> > FortranModuleProviders;
+
   typedef std::map<std::string, cmGeneratorTarget*> TargetAliasMap;
   TargetAliasMap TargetAliases;
 
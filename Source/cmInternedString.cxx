@@ -0,0 +1,70 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmInternedString.h"
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#include <cmsys/hash_set.hxx>
+typedef cmsys::hash_set<std::string> cmInternedStringPool;
+#else
+typedef std::set<std::string> cmInternedStringPool;
+#endif
+
+//----------------------------------------------------------------------------
+// The pool is constructed on first use so that strings may be interned
+// during static initialization.  Both container choices are node based,
+// so the pooled strings never move once inserted.
+static cmInternedStringPool& cmInternedStringGetPool()
+{
+  static cmInternedStringPool pool;
+  return pool;
+}
+
+//----------------------------------------------------------------------------
+static std::string const* cmInternedStringEmpty()
+{
+  static std::string const* empty =
+    &*cmInternedStringGetPool().insert(std::string()).first;
+  return empty;
+}
+
+//----------------------------------------------------------------------------
+cmInternedString::cmInternedString(): String(cmInternedStringEmpty())
+{
+}
+
+//----------------------------------------------------------------------------
+std::string const* cmInternedString::Intern(std::string const& s)
+{
+  if(s.empty())
+    {
+    return cmInternedStringEmpty();
+    }
+  return &*cmInternedStringGetPool().insert(s).first;
+}
+
+//----------------------------------------------------------------------------
+bool cmInternedString::Find(std::string const& s, cmInternedString& result)
+{
+  if(s.empty())
+    {
+    result.String = cmInternedStringEmpty();
+    return true;
+    }
+  cmInternedStringPool const& pool = cmInternedStringGetPool();
+  cmInternedStringPool::const_iterator i = pool.find(s);
+  if(i == pool.end())
+    {
+    return false;
+    }
+  result.String = &*i;
+  return true;
+}
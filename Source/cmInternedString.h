@@ -0,0 +1,89 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmInternedString_h
+#define cmInternedString_h
+
+#include "cmStandardIncludes.h"
+
+/** \class cmInternedString
+ * \brief Immutable string stored once in a process-wide pool.
+ *
+ * Variable names, property names and source paths are used as keys in
+ * many maps and are copied between scopes, targets and source files.
+ * A cmInternedString refers to the single pooled copy of its value, so
+ * copies do not allocate and equality is a pointer comparison.  The
+ * pool is never released.  Ordering compares the string values so
+ * that ordered containers iterate in the same order as they would
+ * with std::string keys.
+ */
+class cmInternedString
+{
+public:
+  /** Construct the empty string.  */
+  cmInternedString();
+
+  cmInternedString(std::string const& s): String(Intern(s)) {}
+  cmInternedString(const char* s): String(Intern(s ? s : "")) {}
+
+  /**
+   * Get the interned string equal to the given value without adding
+   * it to the pool.  Returns false if no such string was ever
+   * interned, in which case no container keyed by cmInternedString
+   * can hold it.
+   */
+  static bool Find(std::string const& s, cmInternedString& result);
+
+  std::string const& str() const { return *this->String; }
+  operator std::string const&() const { return *this->String; }
+  const char* c_str() const { return this->String->c_str(); }
+  std::string::size_type size() const { return this->String->size(); }
+  bool empty() const { return this->String->empty(); }
+  char operator[](std::string::size_type i) const
+    { return (*this->String)[i]; }
+
+  friend bool operator==(cmInternedString const& l,
+                         cmInternedString const& r)
+    { return l.String == r.String; }
+  friend bool operator!=(cmInternedString const& l,
+                         cmInternedString const& r)
+    { return l.String != r.String; }
+  friend bool operator<(cmInternedString const& l,
+                        cmInternedString const& r)
+    { return l.String != r.String && *l.String < *r.String; }
+
+  friend bool operator==(cmInternedString const& l, std::string const& r)
+    { return *l.String == r; }
+  friend bool operator==(std::string const& l, cmInternedString const& r)
+    { return l == *r.String; }
+  friend bool operator!=(cmInternedString const& l, std::string const& r)
+    { return *l.String != r; }
+  friend bool operator!=(std::string const& l, cmInternedString const& r)
+    { return l != *r.String; }
+
+  /** Hash functor for unordered containers.  */
+  struct Hash
+  {
+    size_t operator()(cmInternedString const& s) const
+      { return reinterpret_cast<size_t>(s.String) / sizeof(std::string); }
+  };
+
+private:
+  static std::string const* Intern(std::string const& s);
+  std::string const* String;
+};
+
+inline std::ostream& operator<<(std::ostream& os, cmInternedString const& s)
+{
+  return os << s.str();
+}
+
+#endif
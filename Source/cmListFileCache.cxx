@@ -17,6 +17,10 @@
 #include "cmSystemTools.h"
 #include "cmVersion.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmListFileDiskCache.h"
+#endif
+
 #include <cmsys/RegularExpression.hxx>
 
 
@@ -35,13 +39,14 @@ struct cmListFileParser
   cmListFileLexer* Lexer;
   cmListFileFunction Function;
   enum { SeparationOkay, SeparationWarning, SeparationError} Separation;
+  bool IssuedWarning;
 };
 
 //----------------------------------------------------------------------------
 cmListFileParser::cmListFileParser(cmListFile* lf, cmMakefile* mf,
                                    const char* filename):
   ListFile(lf), Makefile(mf), FileName(filename),
-  Lexer(cmListFileLexer_New())
+  Lexer(cmListFileLexer_New()), IssuedWarning(false)
 {
 }
 
@@ -146,11 +151,28 @@ bool cmListFile::ParseFile(const char* filename,
     }
 
   bool parseError = false;
-
-  {
-  cmListFileParser parser(this, mf, filename);
-  parseError = !parser.ParseFile();
-  }
+  bool cached = false;
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Reuse the result of an earlier configure run if the file has not
+  // changed since.  Files that produced diagnostics are never cached
+  // so that the diagnostics are reported again on every run.
+  cmListFileDiskCache* diskCache =
+    mf->GetCMakeInstance()->GetListFileDiskCache();
+  cached = diskCache->IsEnabled() &&
+           diskCache->Lookup(filename, this->Functions);
+#endif
+
+  if(!cached)
+    {
+    cmListFileParser parser(this, mf, filename);
+    parseError = !parser.ParseFile();
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    if(!parseError && !parser.IssuedWarning && diskCache->IsEnabled())
+      {
+      diskCache->Store(filename, this->Functions);
+      }
+#endif
+    }
 
   // do we need a cmake_policy(VERSION call?
   if(topLevel)
@@ -393,6 +415,7 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
     }
   else
     {
+    this->IssuedWarning = true;
     this->Makefile->IssueMessage(cmake::AUTHOR_WARNING, m.str());
     return true;
     }
@@ -0,0 +1,405 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmListFileDiskCache.h"
+
+#include "cmCryptoHash.h"
+#include "cmGeneratedFileStream.h"
+#include "cmSystemTools.h"
+#include "cmVersion.h"
+
+#include <cmsys/FStream.hxx>
+
+// Bump this when the encoding below changes.
+#define cmListFileDiskCache_FORMAT 1
+
+static const char cmListFileDiskCacheMagic[] = "CMakeListFileCache";
+
+//----------------------------------------------------------------------------
+// All integers are stored as 32-bit little-endian values and all
+// strings are stored as a length followed by the raw bytes.
+static void cmListFileDiskCacheWrite(std::string& out, unsigned long v)
+{
+  char b[4];
+  b[0] = static_cast<char>(v & 0xFF);
+  b[1] = static_cast<char>((v >> 8) & 0xFF);
+  b[2] = static_cast<char>((v >> 16) & 0xFF);
+  b[3] = static_cast<char>((v >> 24) & 0xFF);
+  out.append(b, 4);
+}
+
+//----------------------------------------------------------------------------
+static void cmListFileDiskCacheWrite(std::string& out, std::string const& s)
+{
+  cmListFileDiskCacheWrite(out, static_cast<unsigned long>(s.size()));
+  out.append(s);
+}
+
+//----------------------------------------------------------------------------
+class cmListFileDiskCacheReader
+{
+public:
+  cmListFileDiskCacheReader(const char* begin, const char* end):
+    Cur(begin), End(end) {}
+
+  bool Read(unsigned long& v)
+    {
+    if(this->End - this->Cur < 4)
+      {
+      return false;
+      }
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(this->Cur);
+    v = (static_cast<unsigned long>(b[0])) |
+        (static_cast<unsigned long>(b[1]) << 8) |
+        (static_cast<unsigned long>(b[2]) << 16) |
+        (static_cast<unsigned long>(b[3]) << 24);
+    this->Cur += 4;
+    return true;
+    }
+
+  bool Read(std::string& s)
+    {
+    unsigned long n;
+    if(!this->Read(n) || static_cast<unsigned long>(this->End - this->Cur) < n)
+      {
+      return false;
+      }
+    s.assign(this->Cur, n);
+    this->Cur += n;
+    return true;
+    }
+
+  bool Skip(unsigned long n)
+    {
+    if(static_cast<unsigned long>(this->End - this->Cur) < n)
+      {
+      return false;
+      }
+    this->Cur += n;
+    return true;
+    }
+
+  const char* Cur;
+  const char* End;
+};
+
+//----------------------------------------------------------------------------
+static void
+cmListFileDiskCacheEncode(std::string& out,
+                          std::vector<cmListFileFunction> const& functions)
+{
+  cmListFileDiskCacheWrite(out, static_cast<unsigned long>(functions.size()));
+  for(std::vector<cmListFileFunction>::const_iterator fi = functions.begin();
+      fi != functions.end(); ++fi)
+    {
+    cmListFileDiskCacheWrite(out, fi->Name);
+    cmListFileDiskCacheWrite(out, static_cast<unsigned long>(fi->Line));
+    cmListFileDiskCacheWrite(out,
+                      static_cast<unsigned long>(fi->Arguments.size()));
+    for(std::vector<cmListFileArgument>::const_iterator ai =
+          fi->Arguments.begin(); ai != fi->Arguments.end(); ++ai)
+      {
+      cmListFileDiskCacheWrite(out, ai->Value);
+      cmListFileDiskCacheWrite(out, static_cast<unsigned long>(ai->Delim));
+      cmListFileDiskCacheWrite(out, static_cast<unsigned long>(ai->Line));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+static bool
+cmListFileDiskCacheDecode(const char* begin, const char* end,
+                          std::vector<cmListFileFunction>& functions)
+{
+  cmListFileDiskCacheReader r(begin, end);
+  unsigned long numFunctions;
+  if(!r.Read(numFunctions))
+    {
+    return false;
+    }
+  std::vector<cmListFileFunction> result;
+  result.reserve(numFunctions);
+  for(unsigned long f = 0; f < numFunctions; ++f)
+    {
+    result.push_back(cmListFileFunction());
+    cmListFileFunction& lff = result.back();
+    unsigned long line;
+    unsigned long numArgs;
+    if(!r.Read(lff.Name) || !r.Read(line) || !r.Read(numArgs))
+      {
+      return false;
+      }
+    lff.Line = static_cast<long>(line);
+    lff.Arguments.reserve(numArgs);
+    for(unsigned long a = 0; a < numArgs; ++a)
+      {
+      cmListFileArgument arg;
+      unsigned long delim;
+      if(!r.Read(arg.Value) || !r.Read(delim) || !r.Read(line) ||
+         delim > cmListFileArgument::Bracket)
+        {
+        return false;
+        }
+      arg.Delim = static_cast<cmListFileArgument::Delimiter>(delim);
+      arg.Line = static_cast<long>(line);
+      lff.Arguments.push_back(arg);
+      }
+    }
+  if(r.Cur != r.End)
+    {
+    return false;
+    }
+  functions.swap(result);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+cmListFileDiskCache::cmListFileDiskCache():
+  Enabled(false), Hits(0), Misses(0)
+{
+}
+
+//----------------------------------------------------------------------------
+cmListFileDiskCache::~cmListFileDiskCache()
+{
+}
+
+//----------------------------------------------------------------------------
+std::string cmListFileDiskCache::ComputeHash(std::string const& path)
+{
+  cmCryptoHashMD5 md5;
+  return md5.HashFile(path);
+}
+
+//----------------------------------------------------------------------------
+void cmListFileDiskCache::Load(std::string const& file)
+{
+  this->FileName = file;
+  this->Buffer.clear();
+  this->Entries.clear();
+  this->Enabled = true;
+  this->Hits = 0;
+  this->Misses = 0;
+
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  if(!fin)
+    {
+    return;
+    }
+  fin.seekg(0, std::ios::end);
+  std::streamoff length = fin.tellg();
+  fin.seekg(0, std::ios::beg);
+  if(length <= 0)
+    {
+    return;
+    }
+  this->Buffer.resize(static_cast<size_t>(length));
+  if(!fin.read(&this->Buffer[0], length))
+    {
+    this->Buffer.clear();
+    return;
+    }
+  if(!this->ReadIndex())
+    {
+    // The file is corrupt or was written by another version.
+    this->Buffer.clear();
+    this->Entries.clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmListFileDiskCache::ReadIndex()
+{
+  const char* begin = &this->Buffer[0];
+  cmListFileDiskCacheReader r(begin, begin + this->Buffer.size());
+  std::string magic;
+  std::string version;
+  unsigned long format;
+  if(!r.Read(magic) || magic != cmListFileDiskCacheMagic ||
+     !r.Read(format) || format != cmListFileDiskCache_FORMAT ||
+     !r.Read(version) || version != cmVersion::GetCMakeVersion())
+    {
+    return false;
+    }
+  unsigned long numEntries;
+  if(!r.Read(numEntries))
+    {
+    return false;
+    }
+  for(unsigned long i = 0; i < numEntries; ++i)
+    {
+    std::string path;
+    Entry e;
+    unsigned long mtimeLow;
+    unsigned long mtimeHigh;
+    unsigned long length;
+    if(!r.Read(path) || !r.Read(e.Size) ||
+       !r.Read(mtimeLow) || !r.Read(mtimeHigh) ||
+       !r.Read(e.Hash) || !r.Read(length))
+      {
+      return false;
+      }
+    e.MTime = static_cast<long>(mtimeLow);
+    if(sizeof(long) > 4)
+      {
+      // Shift in two steps to avoid a warning on 32-bit longs.
+      e.MTime |= static_cast<long>(mtimeHigh) << 16 << 16;
+      }
+    e.Offset = static_cast<size_t>(r.Cur - begin);
+    e.Length = length;
+    if(!r.Skip(length))
+      {
+      return false;
+      }
+    this->Entries[path] = e;
+    }
+  return r.Cur == r.End;
+}
+
+//----------------------------------------------------------------------------
+bool cmListFileDiskCache::Lookup(std::string const& path,
+                                 std::vector<cmListFileFunction>& functions)
+{
+  if(!this->Enabled)
+    {
+    return false;
+    }
+  EntryMap::iterator i = this->Entries.find(path);
+  if(i == this->Entries.end())
+    {
+    ++this->Misses;
+    return false;
+    }
+  Entry& e = i->second;
+  if(e.Size != cmSystemTools::FileLength(path) ||
+     e.MTime != cmSystemTools::ModifiedTime(path) ||
+     e.Hash != ComputeHash(path))
+    {
+    ++this->Misses;
+    return false;
+    }
+
+  bool decoded;
+  if(e.Encoded.empty())
+    {
+    const char* begin = &this->Buffer[0] + e.Offset;
+    decoded = cmListFileDiskCacheDecode(begin, begin + e.Length, functions);
+    }
+  else
+    {
+    const char* begin = e.Encoded.c_str();
+    decoded = cmListFileDiskCacheDecode(begin, begin + e.Encoded.size(),
+                                        functions);
+    }
+  if(!decoded)
+    {
+    this->Entries.erase(i);
+    ++this->Misses;
+    return false;
+    }
+  e.Used = true;
+  ++this->Hits;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool cmListFileDiskCache::HasContent(std::string const& path) const
+{
+  EntryMap::const_iterator i = this->Entries.find(path);
+  return (i != this->Entries.end() &&
+          i->second.Size == cmSystemTools::FileLength(path) &&
+          i->second.Hash == ComputeHash(path));
+}
+
+//----------------------------------------------------------------------------
+void cmListFileDiskCache::Store(std::string const& path,
+                                std::vector<cmListFileFunction> const& fns)
+{
+  if(!this->Enabled)
+    {
+    return;
+    }
+  std::string hash = ComputeHash(path);
+  if(hash.empty())
+    {
+    return;
+    }
+  Entry& e = this->Entries[path];
+  e.Size = cmSystemTools::FileLength(path);
+  e.MTime = cmSystemTools::ModifiedTime(path);
+  e.Hash = hash;
+  e.Offset = 0;
+  e.Length = 0;
+  e.Encoded.clear();
+  cmListFileDiskCacheEncode(e.Encoded, fns);
+  e.Used = true;
+}
+
+//----------------------------------------------------------------------------
+bool cmListFileDiskCache::Save()
+{
+  if(!this->Enabled)
+    {
+    return false;
+    }
+  this->Enabled = false;
+
+  // Drop entries for files that were not read by this run so that
+  // the cache does not grow without bound.
+  unsigned long numUsed = 0;
+  for(EntryMap::const_iterator i = this->Entries.begin();
+      i != this->Entries.end(); ++i)
+    {
+    if(i->second.Used)
+      {
+      ++numUsed;
+      }
+    }
+
+  std::string out;
+  cmListFileDiskCacheWrite(out, cmListFileDiskCacheMagic);
+  cmListFileDiskCacheWrite(out, cmListFileDiskCache_FORMAT);
+  cmListFileDiskCacheWrite(out, cmVersion::GetCMakeVersion());
+  cmListFileDiskCacheWrite(out, numUsed);
+  for(EntryMap::const_iterator i = this->Entries.begin();
+      i != this->Entries.end(); ++i)
+    {
+    Entry const& e = i->second;
+    if(!e.Used)
+      {
+      continue;
+      }
+    unsigned long mtime = static_cast<unsigned long>(e.MTime);
+    cmListFileDiskCacheWrite(out, i->first);
+    cmListFileDiskCacheWrite(out, e.Size);
+    cmListFileDiskCacheWrite(out, mtime & 0xFFFFFFFF);
+    cmListFileDiskCacheWrite(out, (mtime >> 16 >> 16) & 0xFFFFFFFF);
+    cmListFileDiskCacheWrite(out, e.Hash);
+    if(e.Encoded.empty())
+      {
+      cmListFileDiskCacheWrite(out, static_cast<unsigned long>(e.Length));
+      out.append(&this->Buffer[0] + e.Offset, e.Length);
+      }
+    else
+      {
+      cmListFileDiskCacheWrite(out, e.Encoded);
+      }
+    }
+
+  cmGeneratedFileStream fout;
+  fout.Open(this->FileName.c_str(), true, true);
+  if(!fout)
+    {
+    return false;
+    }
+  fout.write(out.c_str(), static_cast<std::streamsize>(out.size()));
+  return fout.Close();
+}
@@ -0,0 +1,99 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmListFileDiskCache_h
+#define cmListFileDiskCache_h
+
+#include "cmStandardIncludes.h"
+
+#include "cmListFileCache.h"
+
+/** \class cmListFileDiskCache
+ * \brief Persistent cache of parsed cmake list files.
+ *
+ * cmListFileDiskCache stores the function lists produced by parsing
+ * cmake list files in a binary file in the build tree.  Entries are
+ * keyed by the full path of the list file and are valid only while
+ * the size, modification time and MD5 hash of the file are unchanged.
+ * The whole cache file is read into memory with a single read and
+ * entries are decoded lazily, so files that are not used by a
+ * configure run cost nothing beyond their index entry.
+ */
+class cmListFileDiskCache
+{
+public:
+  cmListFileDiskCache();
+  ~cmListFileDiskCache();
+
+  /**
+   * Load the cache from the given file and enable lookups.  A missing,
+   * unreadable or incompatible file results in an empty cache.
+   */
+  void Load(std::string const& file);
+
+  /**
+   * Write the entries used since the last Load back to the cache file
+   * and disable lookups.
+   */
+  bool Save();
+
+  /** Whether Load has been called without a matching Save.  */
+  bool IsEnabled() const { return this->Enabled; }
+
+  /**
+   * Get the parsed functions of the given list file if an up-to-date
+   * entry exists.  Returns false on a cache miss.
+   */
+  bool Lookup(std::string const& path,
+              std::vector<cmListFileFunction>& functions);
+
+  /**
+   * Whether the given list file still has the size and hash recorded
+   * for it.  Its modification time is ignored so that a file that was
+   * only touched is reported as unchanged.
+   */
+  bool HasContent(std::string const& path) const;
+
+  /** Record the parsed functions of the given list file.  */
+  void Store(std::string const& path,
+             std::vector<cmListFileFunction> const& functions);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    Entry(): Size(0), MTime(0), Offset(0), Length(0), Used(false) {}
+    unsigned long Size;
+    long MTime;
+    std::string Hash;
+    // Location of the encoded function list in the loaded buffer,
+    // or an empty range if the entry was created by Store.
+    size_t Offset;
+    size_t Length;
+    std::string Encoded;
+    bool Used;
+  };
+  typedef std::map<std::string, Entry> EntryMap;
+
+  static std::string ComputeHash(std::string const& path);
+  bool ReadIndex();
+
+  std::string FileName;
+  std::vector<char> Buffer;
+  EntryMap Entries;
+  bool Enabled;
+  unsigned long Hits;
+  unsigned long Misses;
+};
+
+#endif
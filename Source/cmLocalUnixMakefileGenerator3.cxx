@@ -25,6 +25,7 @@
 // Include dependency scanners for supported languages.  Only the
 // C/C++ scanner is needed for bootstrapping CMake.
 #include "cmDependsC.h"
+#include "cmDependsCompiler.h"
 #ifdef CMAKE_BUILD_WITH_CMAKE
 # include "cmDependsFortran.h"
 # include "cmDependsJava.h"
@@ -1513,6 +1514,21 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(const char* tgtInfo,
     }
   }
 
+  // Depfiles written by the compiler since the last scan must be merged.
+  bool needMergeDepfiles = false;
+  std::vector<std::string> depfilePairs;
+  cmSystemTools::ExpandListArgument(
+    this->Makefile->GetSafeDefinition("CMAKE_DEPENDS_DEPENDENCY_FILES"),
+    depfilePairs);
+  if(!depfilePairs.empty())
+    {
+    cmDependsCompiler merger(this);
+    merger.SetVerbose(verbose);
+    merger.SetFileComparison(ftc);
+    needMergeDepfiles =
+      merger.CheckDepfiles(depfilePairs, internalDependFile);
+    }
+
   // Check the implicit dependencies to see if they are up to date.
   // The build.make file may have explicit dependencies for the object
   // files but these will not affect the scanning process so they need
@@ -1553,6 +1569,11 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(const char* tgtInfo,
 
     return this->ScanDependencies(dir.c_str(), validDependencies);
     }
+  else if(needMergeDepfiles)
+    {
+    // Merging depfiles does not scan anything so do it quietly.
+    return this->ScanDependencies(dir.c_str(), validDependencies);
+    }
 
   // The dependencies are already up-to-date.
   return true;
@@ -1678,6 +1699,16 @@ cmLocalUnixMakefileGenerator3
       }
     }
 
+  // Merge the depfiles written by the compiler for the other objects.
+  std::vector<std::string> depfilePairs;
+  cmSystemTools::ExpandListArgument(
+    mf->GetSafeDefinition("CMAKE_DEPENDS_DEPENDENCY_FILES"), depfilePairs);
+  if(!depfilePairs.empty())
+    {
+    cmDependsCompiler merger(this);
+    merger.Write(depfilePairs, ruleFileStream);
+    }
+
   return true;
 }
 
@@ -28,6 +28,7 @@
 #include "cmVersion.h"
 #ifdef CMAKE_BUILD_WITH_CMAKE
 #  include "cmVariableWatch.h"
+#  include "cmMakefileProfilingData.h"
 #endif
 #include "cmAlgorithms.h"
 #include "cmInstallGenerator.h"
@@ -249,6 +250,14 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
   cmMakefileCall stack_manager(this, lff, status);
   static_cast<void>(stack_manager);
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Record the time spent in this call if profiling.
+  cmMakefileProfilingData::CommandScope profiling_scope(
+    this->GetCMakeInstance()->GetProfilingOutput(), lff,
+    this->Backtrace.Top());
+  static_cast<void>(profiling_scope);
+#endif
+
   // Lookup the command prototype.
   if(cmCommand* proto = this->GetState()->GetCommand(name))
     {
@@ -528,6 +537,12 @@ bool cmMakefile::ReadListFile(const char* filename)
 void cmMakefile::ReadListFile(cmListFile const& listFile,
                               std::string const& filenametoread)
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmMakefileProfilingData::ListFileScope profiling_scope(
+    this->GetCMakeInstance()->GetProfilingOutput(), filenametoread);
+  static_cast<void>(profiling_scope);
+#endif
+
   // add this list file to the list of dependencies
   this->ListFiles.push_back(filenametoread);
 
@@ -0,0 +1,252 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmMakefileProfilingData.h"
+
+#include "cmListFileCache.h"
+#include "cmSystemTools.h"
+
+#include "cm_jsoncpp_value.h"
+#include "cm_jsoncpp_writer.h"
+
+// Number of entries listed in each table of the summary.
+#define cmMakefileProfilingData_TOP 10
+
+//----------------------------------------------------------------------------
+cmMakefileProfilingData::cmMakefileProfilingData(std::string const& fileName):
+  Stream(fileName.c_str()), First(true), Origin(cmSystemTools::GetTime())
+{
+  if(this->Stream)
+    {
+    this->Stream << "[";
+    }
+}
+
+//----------------------------------------------------------------------------
+cmMakefileProfilingData::~cmMakefileProfilingData()
+{
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::StartCommand(cmListFileFunction const& lff,
+                                           cmListFileContext const& lfc)
+{
+  double now = cmSystemTools::GetTime();
+  this->Push(this->Commands, this->CommandStats, lff.Name, now);
+
+  std::ostringstream location;
+  location << lfc.FilePath << ":" << lfc.Line;
+  std::string arguments;
+  const char* sep = "";
+  for(std::vector<cmListFileArgument>::const_iterator a =
+        lff.Arguments.begin(); a != lff.Arguments.end(); ++a)
+    {
+    arguments += sep;
+    arguments += a->Value;
+    sep = " ";
+    }
+  this->WriteEvent("B", "command", lff.Name, now, location.str(), arguments);
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::StopCommand()
+{
+  double now = cmSystemTools::GetTime();
+  std::string name = this->Commands.back().Name;
+  this->Pop(this->Commands, this->CommandStats, now);
+  this->WriteEvent("E", "command", name, now);
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::StartListFile(std::string const& fileName)
+{
+  double now = cmSystemTools::GetTime();
+  this->Push(this->ListFiles, this->ListFileStats, fileName, now);
+  this->WriteEvent("B", "listfile", fileName, now);
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::StopListFile()
+{
+  double now = cmSystemTools::GetTime();
+  std::string name = this->ListFiles.back().Name;
+  this->Pop(this->ListFiles, this->ListFileStats, now);
+  this->WriteEvent("E", "listfile", name, now);
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::Push(std::vector<Frame>& stack, StatMap& stats,
+                                   std::string const& name, double now)
+{
+  Frame f;
+  f.Name = name;
+  f.Start = now;
+  stack.push_back(f);
+  Stat& s = stats[name];
+  ++s.Count;
+  ++s.Active;
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::Pop(std::vector<Frame>& stack, StatMap& stats,
+                                  double now)
+{
+  Frame const& f = stack.back();
+  double elapsed = now - f.Start;
+  Stat& s = stats[f.Name];
+  s.Self += elapsed - f.Children;
+  // Count the time of recursive calls only once in the total.
+  if(--s.Active == 0)
+    {
+    s.Total += elapsed;
+    }
+  stack.pop_back();
+  if(!stack.empty())
+    {
+    stack.back().Children += elapsed;
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::WriteEvent(const char* phase,
+                                         const char* category,
+                                         std::string const& name, double now,
+                                         std::string const& location,
+                                         std::string const& arguments)
+{
+  if(!this->Stream)
+    {
+    return;
+    }
+  Json::Value event(Json::objectValue);
+  event["name"] = name;
+  event["cat"] = category;
+  event["ph"] = phase;
+  event["ts"] = static_cast<Json::Int64>((now - this->Origin) * 1000000);
+  event["pid"] = 0;
+  event["tid"] = 0;
+  if(!location.empty())
+    {
+    Json::Value& args = event["args"] = Json::objectValue;
+    args["location"] = location;
+    args["functionArgs"] = arguments;
+    }
+  Json::FastWriter writer;
+  this->Stream << (this->First ? "\n" : ",\n");
+  std::string json = writer.write(event);
+  // Drop the newline appended by the writer.
+  this->Stream.write(json.c_str(),
+                     static_cast<std::streamsize>(json.size() - 1));
+  this->First = false;
+}
+
+//----------------------------------------------------------------------------
+struct cmMakefileProfilingDataEntry
+{
+  std::string const* Name;
+  double Self;
+  double Total;
+  unsigned long Count;
+  bool operator<(cmMakefileProfilingDataEntry const& r) const
+    {
+    // Sort by decreasing self time.
+    return this->Self > r.Self;
+    }
+};
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::PrintTop(std::ostream& os, const char* what,
+                                       StatMap const& stats)
+{
+  std::vector<cmMakefileProfilingDataEntry> entries;
+  for(StatMap::const_iterator i = stats.begin(); i != stats.end(); ++i)
+    {
+    cmMakefileProfilingDataEntry e;
+    e.Name = &i->first;
+    e.Self = i->second.Self;
+    e.Total = i->second.Total;
+    e.Count = i->second.Count;
+    entries.push_back(e);
+    }
+  std::stable_sort(entries.begin(), entries.end());
+  if(entries.size() > cmMakefileProfilingData_TOP)
+    {
+    entries.resize(cmMakefileProfilingData_TOP);
+    }
+
+  os << "Top " << entries.size() << " " << what << " by self time:\n"
+     << "      self[s]    total[s]      calls  name\n";
+  char buf[64];
+  for(std::vector<cmMakefileProfilingDataEntry>::const_iterator e =
+        entries.begin(); e != entries.end(); ++e)
+    {
+    sprintf(buf, "  %11.6f %11.6f %10lu  ", e->Self, e->Total, e->Count);
+    os << buf << *e->Name << "\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmMakefileProfilingData::Finish()
+{
+  if(this->Stream)
+    {
+    this->Stream << "\n]\n";
+    this->Stream.close();
+    }
+
+  std::ostringstream msg;
+  PrintTop(msg, "commands", this->CommandStats);
+  PrintTop(msg, "list files", this->ListFileStats);
+  std::string summary = msg.str();
+  // The message adds its own newline.
+  summary.resize(summary.size() - 1);
+  cmSystemTools::Message(summary.c_str());
+}
+
+//----------------------------------------------------------------------------
+cmMakefileProfilingData::CommandScope
+::CommandScope(cmMakefileProfilingData* data, cmListFileFunction const& lff,
+               cmListFileContext const& lfc): Data(data)
+{
+  if(this->Data)
+    {
+    this->Data->StartCommand(lff, lfc);
+    }
+}
+
+//----------------------------------------------------------------------------
+cmMakefileProfilingData::CommandScope::~CommandScope()
+{
+  if(this->Data)
+    {
+    this->Data->StopCommand();
+    }
+}
+
+//----------------------------------------------------------------------------
+cmMakefileProfilingData::ListFileScope
+::ListFileScope(cmMakefileProfilingData* data, std::string const& fileName):
+  Data(data)
+{
+  if(this->Data)
+    {
+    this->Data->StartListFile(fileName);
+    }
+}
+
+//----------------------------------------------------------------------------
+cmMakefileProfilingData::ListFileScope::~ListFileScope()
+{
+  if(this->Data)
+    {
+    this->Data->StopListFile();
+    }
+}
@@ -0,0 +1,114 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmMakefileProfilingData_h
+#define cmMakefileProfilingData_h
+
+#include "cmStandardIncludes.h"
+
+#include <cmsys/FStream.hxx>
+
+class cmListFileContext;
+struct cmListFileFunction;
+
+/** \class cmMakefileProfilingData
+ * \brief Record the time spent in list files and commands.
+ *
+ * cmMakefileProfilingData writes a Chrome trace event file with one
+ * pair of begin and end events for every list file read and every
+ * command executed.  Function, macro and include calls nest naturally
+ * because their bodies run while the calling command is still open.
+ * It also accumulates self and total time per command name and per
+ * list file for a summary of the most expensive entries.
+ */
+class cmMakefileProfilingData
+{
+public:
+  cmMakefileProfilingData(std::string const& fileName);
+  ~cmMakefileProfilingData();
+
+  /** Whether the trace file could be opened for writing.  */
+  bool IsOpen() const { return this->Stream ? true : false; }
+
+  /** Begin and end the execution of a command.  */
+  void StartCommand(cmListFileFunction const& lff,
+                    cmListFileContext const& lfc);
+  void StopCommand();
+
+  /** Begin and end reading a list file.  */
+  void StartListFile(std::string const& fileName);
+  void StopListFile();
+
+  /**
+   * Close the trace file and print the commands and list files with
+   * the highest self time.  No further entries may be recorded.
+   */
+  void Finish();
+
+  /** Record one command or list file for the lifetime of the object.  */
+  class CommandScope
+  {
+  public:
+    CommandScope(cmMakefileProfilingData* data,
+                 cmListFileFunction const& lff,
+                 cmListFileContext const& lfc);
+    ~CommandScope();
+  private:
+    cmMakefileProfilingData* Data;
+  };
+  class ListFileScope
+  {
+  public:
+    ListFileScope(cmMakefileProfilingData* data,
+                  std::string const& fileName);
+    ~ListFileScope();
+  private:
+    cmMakefileProfilingData* Data;
+  };
+
+private:
+  struct Frame
+  {
+    Frame(): Start(0), Children(0) {}
+    std::string Name;
+    double Start;
+    double Children;
+  };
+  struct Stat
+  {
+    Stat(): Count(0), Active(0), Self(0), Total(0) {}
+    unsigned long Count;
+    unsigned long Active;
+    double Self;
+    double Total;
+  };
+  typedef std::map<std::string, Stat> StatMap;
+
+  void Push(std::vector<Frame>& stack, StatMap& stats,
+            std::string const& name, double now);
+  void Pop(std::vector<Frame>& stack, StatMap& stats, double now);
+  void WriteEvent(const char* phase, const char* category,
+                  std::string const& name, double now,
+                  std::string const& location = std::string(),
+                  std::string const& arguments = std::string());
+  static void PrintTop(std::ostream& os, const char* what,
+                       StatMap const& stats);
+
+  cmsys::ofstream Stream;
+  bool First;
+  double Origin;
+  std::vector<Frame> Commands;
+  std::vector<Frame> ListFiles;
+  StatMap CommandStats;
+  StatMap ListFileStats;
+};
+
+#endif
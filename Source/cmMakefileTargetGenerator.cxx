@@ -202,6 +202,19 @@ void cmMakefileTargetGenerator::WriteTargetBuildRules()
     {
     this->ExternalObjects.push_back((*si)->GetFullPath());
     }
+
+  // Generate the rules compiling the precompiled headers.
+  std::set<std::string> languages;
+  this->GeneratorTarget->GetLanguages(languages, config);
+  for(std::set<std::string>::const_iterator li = languages.begin();
+      li != languages.end(); ++li)
+    {
+    if(cmSourceFile const* pch = this->GetPchHeaderSource(*li))
+      {
+      this->WriteObjectRuleFiles(*pch);
+      }
+    }
+
   std::vector<cmSourceFile const*> objectSources;
   this->GeneratorTarget->GetObjectSources(objectSources, config);
   for(std::vector<cmSourceFile const*>::const_iterator
@@ -375,13 +388,22 @@ void cmMakefileTargetGenerator
     return;
     }
 
-  // Get the full path name of the object file.
-  std::string const& objectName = this->GeneratorTarget
-                                      ->GetObjectName(&source);
-  std::string obj =
-      this->LocalGenerator->GetTargetDirectory(this->GeneratorTarget);
-  obj += "/";
-  obj += objectName;
+  // Get the full path name of the object file.  The object of a
+  // precompiled header is the precompiled header file.
+  bool const isPchHeader = this->IsPchHeaderSource(source, lang);
+  std::string obj;
+  if(isPchHeader)
+    {
+    obj = this->Convert(
+      this->GeneratorTarget->GetPchFile(this->ConfigName, lang),
+      cmLocalGenerator::START_OUTPUT);
+    }
+  else
+    {
+    obj = this->LocalGenerator->GetTargetDirectory(this->GeneratorTarget);
+    obj += "/";
+    obj += this->GeneratorTarget->GetObjectName(&source);
+    }
 
   // Avoid generating duplicate rules.
   if(this->ObjectFiles.find(obj) == this->ObjectFiles.end())
@@ -407,7 +429,10 @@ void cmMakefileTargetGenerator
     (this->LocalGenerator->ConvertToFullPath(dir).c_str());
 
   // Save this in the target's list of object files.
-  this->Objects.push_back(obj);
+  if(!isPchHeader)
+    {
+    this->Objects.push_back(obj);
+    }
   this->CleanFiles.push_back(obj);
 
   // TODO: Remove
@@ -428,6 +453,14 @@ void cmMakefileTargetGenerator
   objFullPath += obj;
   objFullPath =
     this->Convert(objFullPath, cmLocalGenerator::FULL);
+  if(this->UseCompilerDepfile(lang))
+    {
+    // The compiler lists the dependencies so nothing is scanned.
+    this->CompilerDepends.push_back(objFullPath);
+    this->CompilerDepends.push_back(objFullPath + ".d");
+    this->CleanFiles.push_back(obj + ".d");
+    return;
+    }
   std::string srcFullPath =
     this->Convert(source.GetFullPath(), cmLocalGenerator::FULL);
   this->LocalGenerator->
@@ -437,6 +470,22 @@ void cmMakefileTargetGenerator
 }
 
 //----------------------------------------------------------------------------
+bool
+cmMakefileTargetGenerator::UseCompilerDepfile(const std::string& lang) const
+{
+  if((lang != "C" && lang != "CXX") ||
+     !this->Makefile->IsOn("CMAKE_DEPENDS_USE_COMPILER"))
+    {
+    return false;
+    }
+  // Only depfiles in the format of make rules can be merged.
+  const char* format =
+    this->Makefile->GetDefinition("CMAKE_" + lang + "_DEPFILE_FORMAT");
+  const char* flags =
+    this->Makefile->GetDefinition("CMAKE_DEPFILE_FLAGS_" + lang);
+  return format && strcmp(format, "gcc") == 0 && flags && *flags;
+}
+
 void
 cmMakefileTargetGenerator
 ::WriteObjectBuildFile(std::string &obj,
@@ -449,6 +498,14 @@ cmMakefileTargetGenerator
   this->LocalGenerator->AppendRuleDepends(depends,
                                           this->FlagFileDepends[lang]);
 
+  // Compile the precompiled header this source uses first.
+  std::string const pchFile = this->GetPchFileForSource(source, lang);
+  if(!pchFile.empty())
+    {
+    depends.push_back(pchFile);
+    }
+  bool const isPchHeader = this->IsPchHeaderSource(source, lang);
+
   // generate the depend scanning rule
   this->WriteObjectDependRules(source, depends);
 
@@ -486,6 +543,8 @@ cmMakefileTargetGenerator
                           << "\n";
     }
 
+  this->AppendPchFlags(flags, source, lang);
+
   // Add language-specific defines.
   std::set<std::string> defines;
 
@@ -624,8 +683,10 @@ cmMakefileTargetGenerator
 
   // At the moment, it is assumed that C, C++, and Fortran have both
   // assembly and preprocessor capabilities. The same is true for the
-  // ability to export compile commands
-  bool lang_has_preprocessor = ((lang == "C") ||
+  // ability to export compile commands.  Precompiled headers get none
+  // of these rules.
+  bool lang_has_preprocessor = !isPchHeader &&
+                               ((lang == "C") ||
                                 (lang == "CXX") ||
                                 (lang == "Fortran"));
   bool const lang_has_assembly = lang_has_preprocessor;
@@ -662,6 +723,20 @@ cmMakefileTargetGenerator
       source.GetFullPath(), workingDirectory, compileCommand);
     }
 
+  // Let the compiler write the dependencies of the object.  This is
+  // not part of the exported compile command.
+  if(this->UseCompilerDepfile(lang))
+    {
+    std::string depfileFlags =
+      this->Makefile->GetSafeDefinition("CMAKE_DEPFILE_FLAGS_" + lang);
+    cmSystemTools::ReplaceString(depfileFlags, "<DEPFILE>",
+      this->Convert(obj + ".d", cmLocalGenerator::NONE,
+                    cmLocalGenerator::SHELL).c_str());
+    cmSystemTools::ReplaceString(depfileFlags, "<OBJECT>", shellObj.c_str());
+    this->LocalGenerator->AppendFlags(flags, depfileFlags);
+    vars.Flags = flags.c_str();
+    }
+
   // Maybe insert an include-what-you-use runner.
   if (!compileCommands.empty() && (lang == "C" || lang == "CXX"))
     {
@@ -1089,6 +1164,24 @@ void cmMakefileTargetGenerator::WriteTargetDependRules()
     << "  )\n";
   }
 
+  // Store the depfiles written by the compiler for merging.
+  if(!this->CompilerDepends.empty())
+    {
+    *this->InfoFileStream
+      << "\n"
+      << "# Objects and the depfiles the compiler writes for them.\n"
+      << "set(CMAKE_DEPENDS_DEPENDENCY_FILES\n";
+    for(std::vector<std::string>::const_iterator i =
+          this->CompilerDepends.begin();
+        i != this->CompilerDepends.end(); i += 2)
+      {
+      *this->InfoFileStream
+        << "  " << cmOutputConverter::EscapeForCMake(*i)
+        << " "  << cmOutputConverter::EscapeForCMake(*(i+1)) << "\n";
+      }
+    *this->InfoFileStream << "  )\n";
+    }
+
   *this->InfoFileStream
     << "\n"
     << "# Fortran module output directory.\n"
@@ -97,6 +97,10 @@ protected:
                             cmSourceFile const& source,
                             std::vector<std::string>& depends);
 
+  // whether the compiler writes the dependencies of objects of the
+  // language to a depfile merged in place of scanning the sources
+  bool UseCompilerDepfile(const std::string& lang) const;
+
   // write the depend.make file for an object
   void WriteObjectDependRules(cmSourceFile const& source,
                               std::vector<std::string>& depends);
@@ -212,6 +216,9 @@ protected:
   // Set of extra output files to be driven by the build.
   std::set<std::string> ExtraFiles;
 
+  // Full paths of objects and the depfiles written by the compiler.
+  std::vector<std::string> CompilerDepends;
+
   typedef std::map<std::string, std::string> MultipleOutputPairsType;
   MultipleOutputPairsType MultipleOutputPairs;
   bool WriteMakeRule(std::ostream& os,
@@ -122,6 +122,8 @@ cmNinjaTargetGenerator::ComputeFlagsForObject(cmSourceFile const* source,
   this->LocalGenerator->AppendFlags(flags,
     source->GetProperty("COMPILE_FLAGS"));
 
+  this->AppendPchFlags(flags, *source, language);
+
   return flags;
 }
 
@@ -385,7 +387,10 @@ cmNinjaTargetGenerator
       cldeps += "\" \"" + cl + "\" ";
       }
     }
-  else
+  // A Fortran compiler that cannot write a depfile gets its included
+  // files from the scan for module dependencies instead.
+  else if (lang != "Fortran" ||
+           mf->GetDefinition("CMAKE_DEPFILE_FLAGS_Fortran"))
     {
     deptype = "gcc";
     const char* langdeptype = mf->GetDefinition("CMAKE_NINJA_DEPTYPE_" + lang);
@@ -571,6 +576,19 @@ cmNinjaTargetGenerator
                                                 cmNinjaDeps(),
                                                 orderOnlyDeps);
     }
+
+  // Compile the precompiled headers used by the objects.
+  std::set<std::string> languages;
+  this->GeneratorTarget->GetLanguages(languages, config);
+  for(std::set<std::string>::const_iterator li = languages.begin();
+      li != languages.end(); ++li)
+    {
+    if(cmSourceFile const* pch = this->GetPchHeaderSource(*li))
+      {
+      this->WriteObjectBuildStatement(pch, !orderOnlyDeps.empty());
+      }
+    }
+
   std::vector<cmSourceFile const*> objectSources;
   this->GeneratorTarget->GetObjectSources(objectSources, config);
   for(std::vector<cmSourceFile const*>::const_iterator
@@ -591,7 +609,12 @@ cmNinjaTargetGenerator
   std::string const sourceFileName =
     language=="RC" ? source->GetFullPath() : this->GetSourceFilePath(source);
   std::string const objectDir = this->GeneratorTarget->GetSupportDirectory();
-  std::string const objectFileName = this->GetObjectFilePath(source);
+  // The object of a precompiled header is the precompiled header file.
+  bool const isPchHeader = this->IsPchHeaderSource(*source, language);
+  std::string const objectFileName = isPchHeader ?
+    this->ConvertToNinjaPath(
+      this->GeneratorTarget->GetPchFile(this->GetConfigName(), language)) :
+    this->GetObjectFilePath(source);
   std::string const objectFileDir =
     cmSystemTools::GetFilenamePath(objectFileName);
 
@@ -605,11 +628,14 @@ cmNinjaTargetGenerator
       cmGlobalNinjaGenerator::EncodeDepfileSpace(objectFileName + ".d");
     }
 
-  this->ExportObjectCompileCommand(
-    language, sourceFileName,
-    objectDir, objectFileName, objectFileDir,
-    vars["FLAGS"], vars["DEFINES"], vars["INCLUDES"]
-    );
+  if (!isPchHeader)
+    {
+    this->ExportObjectCompileCommand(
+      language, sourceFileName,
+      objectDir, objectFileName, objectFileDir,
+      vars["FLAGS"], vars["DEFINES"], vars["INCLUDES"]
+      );
+    }
 
   std::string comment;
   std::string rule = this->LanguageCompilerRule(language);
@@ -617,7 +643,10 @@ cmNinjaTargetGenerator
   cmNinjaDeps outputs;
   outputs.push_back(objectFileName);
   // Add this object to the list of object files.
-  this->Objects.push_back(objectFileName);
+  if (!isPchHeader)
+    {
+    this->Objects.push_back(objectFileName);
+    }
 
   cmNinjaDeps explicitDeps;
   explicitDeps.push_back(sourceFileName);
@@ -638,6 +667,20 @@ cmNinjaTargetGenerator
                    std::back_inserter(implicitDeps), MapToNinjaPath());
   }
 
+  // Compile the precompiled header this source uses first.
+  std::string const pchFile = this->GetPchFileForSource(*source, language);
+  if (!pchFile.empty())
+    {
+    implicitDeps.push_back(this->ConvertToNinjaPath(pchFile));
+    }
+
+  // Compile the objects providing Fortran modules this source uses first.
+  if (language == "Fortran")
+    {
+    this->GetGlobalGenerator()->AppendFortranObjectDepends(
+      this->GeneratorTarget, source, implicitDeps);
+    }
+
   cmNinjaDeps orderOnlyDeps;
   if (writeOrderDependsTargetForTarget)
     {
@@ -19,24 +19,18 @@
 
 cmProperty *cmPropertyMap::GetOrCreateProperty(const std::string& name)
 {
-  cmPropertyMap::iterator it = this->find(name);
-  cmProperty *prop;
-  if (it == this->end())
-    {
-    prop = &(*this)[name];
-    }
-  else
-    {
-    prop = &(it->second);
-    }
-  return prop;
+  return &(*this)[cmInternedString(name)];
 }
 
 void cmPropertyMap::SetProperty(const std::string& name, const char *value)
 {
   if(!value)
     {
-    this->erase(name);
+    cmInternedString key;
+    if (cmInternedString::Find(name, key))
+      {
+      this->erase(key);
+      }
     return;
     }
 
@@ -62,7 +56,13 @@ const char *cmPropertyMap
 {
   assert(!name.empty());
 
-  cmPropertyMap::const_iterator it = this->find(name);
+  // A name that was never interned cannot be a key in any map.
+  cmInternedString key;
+  if (!cmInternedString::Find(name, key))
+    {
+    return 0;
+    }
+  cmPropertyMap::const_iterator it = this->find(key);
   if (it == this->end())
     {
     return 0;
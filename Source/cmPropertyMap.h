@@ -13,8 +13,9 @@
 #define cmPropertyMap_h
 
 #include "cmProperty.h"
+#include "cmInternedString.h"
 
-class cmPropertyMap : public std::map<std::string,cmProperty>
+class cmPropertyMap : public std::map<cmInternedString,cmProperty>
 {
 public:
   cmProperty *GetOrCreateProperty(const std::string& name);
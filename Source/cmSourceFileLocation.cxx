@@ -193,7 +193,7 @@ cmSourceFileLocation
 
   // Only a fixed set of extensions will be tried to match a file on
   // disk.  One of these must match if loc refers to this source file.
-  std::string const& ext = this->Name.substr(loc.Name.size()+1);
+  std::string const& ext = this->Name.str().substr(loc.Name.size()+1);
   cmMakefile const* mf = this->Makefile;
   const std::vector<std::string>& srcExts =
       mf->GetCMakeInstance()->GetSourceExtensions();
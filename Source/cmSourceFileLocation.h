@@ -14,6 +14,8 @@
 
 #include "cmStandardIncludes.h"
 
+#include "cmInternedString.h"
+
 class cmMakefile;
 
 /** \class cmSourceFileLocation
@@ -89,8 +91,8 @@ private:
   cmMakefile const* Makefile;
   bool AmbiguousDirectory;
   bool AmbiguousExtension;
-  std::string Directory;
-  std::string Name;
+  cmInternedString Directory;
+  cmInternedString Name;
 
   bool MatchesAmbiguousExtension(cmSourceFileLocation const& loc) const;
 
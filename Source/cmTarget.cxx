@@ -157,6 +157,8 @@ void cmTarget::SetMakefile(cmMakefile* mf)
     this->SetPropertyDefault("CXX_EXTENSIONS", 0);
     this->SetPropertyDefault("LINK_SEARCH_START_STATIC", 0);
     this->SetPropertyDefault("LINK_SEARCH_END_STATIC", 0);
+    this->SetPropertyDefault("UNITY_BUILD", 0);
+    this->SetPropertyDefault("UNITY_BUILD_BATCH_SIZE", 0);
     }
 
   // Collect the set of configuration types.
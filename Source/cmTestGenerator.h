@@ -31,6 +31,8 @@ public:
 
   void Compute(cmLocalGenerator* lg);
 
+  cmTest* GetTest() const { return this->Test; }
+
 protected:
   virtual void GenerateScriptConfigs(std::ostream& os, Indent const& indent);
   virtual void GenerateScriptActions(std::ostream& os, Indent const& indent);
@@ -17,6 +17,7 @@
 #include "cmDocumentationFormatter.h"
 #include "cmExternalMakefileProjectGenerator.h"
 #include "cmFileTimeComparison.h"
+#include "cmGeneratorExpression.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
 #include "cmSourceFile.h"
@@ -24,7 +25,11 @@
 #include "cmTest.h"
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmBuildSystemStamp.h"
 # include "cmGraphVizWriter.h"
+# include "cmListFileDiskCache.h"
+# include "cmMakefileProfilingData.h"
+# include "cmGenerateProfile.h"
 # include "cmVariableWatch.h"
 # include <cmsys/SystemInformation.hxx>
 #endif
@@ -131,6 +136,9 @@ cmake::cmake()
   this->DebugTryCompile = false;
   this->ClearBuildSystem = false;
   this->FileComparison = new cmFileTimeComparison;
+  this->ListFileDiskCache = 0;
+  this->ProfilingOutput = 0;
+  this->GenerateProfile = 0;
 
   this->State = new cmState;
   this->CurrentSnapshot = this->State->CreateBaseSnapshot();
@@ -155,6 +163,7 @@ cmake::cmake()
 
 #ifdef CMAKE_BUILD_WITH_CMAKE
   this->VariableWatch = new cmVariableWatch;
+  this->ListFileDiskCache = new cmListFileDiskCache;
 #endif
 
   this->AddDefaultGenerators();
@@ -200,6 +209,9 @@ cmake::~cmake()
   cmDeleteAll(this->Generators);
 #ifdef CMAKE_BUILD_WITH_CMAKE
   delete this->VariableWatch;
+  delete this->ListFileDiskCache;
+  delete this->ProfilingOutput;
+  delete this->GenerateProfile;
 #endif
   delete this->FileComparison;
 }
@@ -685,6 +697,41 @@ void cmake::SetArgs(const std::vector<std::string>& args,
         cmSystemTools::Error("No file specified for --graphviz");
         }
       }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    else if(arg.find("--profiling-output=",0) == 0)
+      {
+      std::string path = arg.substr(strlen("--profiling-output="));
+      if(path.empty())
+        {
+        cmSystemTools::Error("No file specified for --profiling-output");
+        }
+      else
+        {
+        path = cmSystemTools::CollapseFullPath(path);
+        delete this->ProfilingOutput;
+        this->ProfilingOutput = new cmMakefileProfilingData(path);
+        if(!this->ProfilingOutput->IsOpen())
+          {
+          cmSystemTools::Error("Could not open --profiling-output file ",
+                               path.c_str());
+          }
+        }
+      }
+    else if(arg.find("--generate-profile=",0) == 0)
+      {
+      std::string path = arg.substr(strlen("--generate-profile="));
+      if(path.empty())
+        {
+        cmSystemTools::Error("No file specified for --generate-profile");
+        }
+      else
+        {
+        path = cmSystemTools::CollapseFullPath(path);
+        delete this->GenerateProfile;
+        this->GenerateProfile = new cmGenerateProfile(path);
+        }
+      }
+#endif
     else if(arg.find("--debug-trycompile",0) == 0)
       {
       std::cout << "debug trycompile on\n";
@@ -1567,8 +1614,41 @@ int cmake::ActualConfigure()
     this->TruncateOutputLog("CMakeError.log");
     }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Try-compile projects are configured once in a fresh directory
+  // so there is nothing to gain from caching their list files.
+  std::string listFileCache = this->GetHomeOutputDirectory();
+  listFileCache += cmake::GetCMakeFilesDirectory();
+  listFileCache += "/CMakeListFileCache.bin";
+  if(this->GetWorkingMode() == NORMAL_MODE &&
+     !this->State->GetIsInTryCompile())
+    {
+    this->ListFileDiskCache->Load(listFileCache);
+    // The cache also records the content of the list files that the
+    // build system was generated from.  Keep it only if this run
+    // generates a build system, so that a failed run is not mistaken
+    // for an up-to-date one.
+    cmSystemTools::RemoveFile(listFileCache);
+    }
+#endif
+
   // actually do the configure
   this->GlobalGenerator->Configure();
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if(this->ListFileDiskCache->IsEnabled())
+    {
+    if(this->GetTrace())
+      {
+      std::ostringstream msg;
+      msg << "List file cache: "
+          << this->ListFileDiskCache->GetHits() << " hits, "
+          << this->ListFileDiskCache->GetMisses() << " misses";
+      cmSystemTools::Message(msg.str().c_str());
+      }
+    }
+#endif
+  this->FinishProfiling();
   // Before saving the cache
   // if the project did not define one of the entries below, add them now
   // so users can edit the values in the cache:
@@ -1692,6 +1772,7 @@ int cmake::Run(const std::vector<std::string>& args, bool noconfigure)
   // In script mode we terminate after running the script.
   if(this->GetWorkingMode() != NORMAL_MODE)
     {
+    this->FinishProfiling();
     if(cmSystemTools::GetErrorOccuredFlag())
       {
       return -1;
@@ -1760,11 +1841,46 @@ int cmake::Generate()
     {
     return -1;
     }
+  cmGeneratorExpression::GetStatistics() =
+    cmGeneratorExpression::Statistics();
+  {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmGenerateProfile::Scope profileScope(this->GenerateProfile, "Compute");
+#endif
   if (!this->GlobalGenerator->Compute())
     {
     return -1;
     }
+  }
+  {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmGenerateProfile::Scope profileScope(this->GenerateProfile, "Generate");
+#endif
   this->GlobalGenerator->Generate();
+  }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if(this->GenerateProfile)
+    {
+    if(!this->GenerateProfile->Write())
+      {
+      cmSystemTools::Error("Could not write --generate-profile file.");
+      }
+    delete this->GenerateProfile;
+    this->GenerateProfile = 0;
+    }
+#endif
+  if(this->GetTrace())
+    {
+    cmGeneratorExpression::Statistics const& stats =
+      cmGeneratorExpression::GetStatistics();
+    std::ostringstream msg;
+    msg << "Generator expression cache: "
+        << stats.MemoHits << " hits, "
+        << stats.MemoMisses << " misses, "
+        << stats.NotMemoizable << " not memoizable, "
+        << stats.Literal << " literal";
+    cmSystemTools::Message(msg.str().c_str());
+    }
   if ( !this->GraphVizFile.empty() )
     {
     std::cout << "Generate graphviz: " << this->GraphVizFile << std::endl;
@@ -1778,6 +1894,12 @@ int cmake::Generate()
     {
     return -1;
     }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if(this->ListFileDiskCache->IsEnabled())
+    {
+    this->ListFileDiskCache->Save();
+    }
+#endif
   // Save the cache again after a successful Generate so that any internal
   // variables created during Generate are saved. (Specifically target GUIDs
   // for the Visual Studio and Xcode generators.)
@@ -2065,6 +2187,17 @@ int cmake::CheckBuildSystem()
     return 1;
     }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // The stamp written by the last check that found the build system up
+  // to date answers the check without reading the check file as long
+  // as none of the files it records changed.
+  std::string const stampFile = this->CheckBuildSystemArgument + ".stamp";
+  if(!this->ClearBuildSystem && cmBuildSystemStamp::Check(stampFile))
+    {
+    return 0;
+    }
+#endif
+
   // Read the rerun check file and use it to decide whether to do the
   // global generate.
   cmake cm;
@@ -2215,6 +2348,19 @@ int cmake::CheckBuildSystem()
                                             &result) ||
      result < 0)
     {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    if(this->CheckBuildSystemContent(depends, out_oldest, verbose))
+      {
+      // Make the outputs newer than the touched list files so that
+      // the next check does not hash their content again.
+      for(out = outputs.begin(); out != outputs.end(); ++out)
+        {
+        cmSystemTools::Touch(*out, false);
+        }
+      this->WriteBuildSystemStamp(stampFile, products, depends, outputs);
+      return 0;
+      }
+#endif
     if(verbose)
       {
       std::ostringstream msg;
@@ -2227,9 +2373,92 @@ int cmake::CheckBuildSystem()
   }
 
   // No need to rerun.
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  this->WriteBuildSystemStamp(stampFile, products, depends, outputs);
+#endif
   return 0;
 }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+//----------------------------------------------------------------------------
+bool cmake::CheckBuildSystemContent(std::vector<std::string> const& depends,
+                                    std::string const& output, bool verbose)
+{
+  // The list file cache records the size and hash of every list file
+  // read by the last configure step.
+  std::string listFileCache = this->GetHomeOutputDirectory();
+  listFileCache += cmake::GetCMakeFilesDirectory();
+  listFileCache += "/CMakeListFileCache.bin";
+  cmListFileDiskCache cache;
+  cache.Load(listFileCache);
+
+  std::vector<std::string> touched;
+  for(std::vector<std::string>::const_iterator dep = depends.begin();
+      dep != depends.end(); ++dep)
+    {
+    int result = 0;
+    if(!this->FileComparison->FileTimeCompare(output.c_str(), dep->c_str(),
+                                              &result))
+      {
+      return false;
+      }
+    if(result >= 0)
+      {
+      continue;
+      }
+    std::string path = cmSystemTools::CollapseFullPath(*dep);
+    if(!cache.HasContent(path))
+      {
+      return false;
+      }
+    touched.push_back(*dep);
+    }
+
+  if(verbose)
+    {
+    for(std::vector<std::string>::const_iterator t = touched.begin();
+        t != touched.end(); ++t)
+      {
+      std::ostringstream msg;
+      msg << "Skip re-run of cmake, file touched but not modified: "
+          << *t << "\n";
+      cmSystemTools::Stdout(msg.str().c_str());
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void cmake::WriteBuildSystemStamp(std::string const& stampFile,
+                                  std::vector<std::string> const& products,
+                                  std::vector<std::string> const& depends,
+                                  std::vector<std::string> const& outputs)
+{
+  // The check file itself is recorded so that re-generating the build
+  // system invalidates the stamp.
+  std::vector<std::string> files;
+  files.reserve(1 + products.size() + depends.size() + outputs.size());
+  files.push_back(this->CheckBuildSystemArgument);
+  files.insert(files.end(), products.begin(), products.end());
+  files.insert(files.end(), depends.begin(), depends.end());
+  files.insert(files.end(), outputs.begin(), outputs.end());
+  cmBuildSystemStamp::Write(stampFile, files);
+}
+#endif
+
+//----------------------------------------------------------------------------
+void cmake::FinishProfiling()
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if(this->ProfilingOutput)
+    {
+    this->ProfilingOutput->Finish();
+    delete this->ProfilingOutput;
+    this->ProfilingOutput = 0;
+    }
+#endif
+}
+
 //----------------------------------------------------------------------------
 void cmake::TruncateOutputLog(const char* fname)
 {
@@ -27,6 +27,9 @@ class cmLocalGenerator;
 class cmMakefile;
 class cmVariableWatch;
 class cmFileTimeComparison;
+class cmListFileDiskCache;
+class cmMakefileProfilingData;
+class cmGenerateProfile;
 class cmExternalMakefileProjectGenerator;
 class cmDocumentationSection;
 class cmTarget;
@@ -283,6 +286,26 @@ class cmake
    */
   cmFileTimeComparison* GetFileComparison() { return this->FileComparison; }
 
+  /**
+   * Get the persistent cache of parsed list files
+   */
+  cmListFileDiskCache* GetListFileDiskCache()
+    { return this->ListFileDiskCache; }
+
+  /**
+   * Get the recorder of list file and command timing requested by
+   * --profiling-output, or null if profiling is off.
+   */
+  cmMakefileProfilingData* GetProfilingOutput()
+    { return this->ProfilingOutput; }
+
+  /**
+   * Get the recorder of generate step phases requested by
+   * --generate-profile, or null if it was not requested.
+   */
+  cmGenerateProfile* GetGenerateProfile()
+    { return this->GenerateProfile; }
+
   // Do we want debug output during the cmake run.
   bool GetDebugOutput() { return this->DebugOutput; }
   void SetDebugOutputOn(bool b) { this->DebugOutput = b;}
@@ -409,12 +432,32 @@ protected:
   ///  If it is set, truncate it to 50kb
   void TruncateOutputLog(const char* fname);
 
+  ///! Write the profiling output and summary, if requested.
+  void FinishProfiling();
+
   /**
    * Method called to check build system integrity at build time.
    * Returns 1 if CMake should rerun and 0 otherwise.
    */
   int CheckBuildSystem();
 
+  /**
+   * Check whether every dependency newer than the given build system
+   * output still has the content recorded when CMake last ran.  Such
+   * dependencies were only touched and do not require a re-run.
+   */
+  bool CheckBuildSystemContent(std::vector<std::string> const& depends,
+                               std::string const& output, bool verbose);
+
+  /**
+   * Record the files found up to date by the build system check so
+   * that the next check only needs to compare their times.
+   */
+  void WriteBuildSystemStamp(std::string const& stampFile,
+                             std::vector<std::string> const& products,
+                             std::vector<std::string> const& depends,
+                             std::vector<std::string> const& outputs);
+
   void SetDirectoriesFromFile(const char* arg);
 
   //! Make sure all commands are what they say they are and there is no
@@ -453,6 +496,9 @@ private:
   bool ClearBuildSystem;
   bool DebugTryCompile;
   cmFileTimeComparison* FileComparison;
+  cmListFileDiskCache* ListFileDiskCache;
+  cmMakefileProfilingData* ProfilingOutput;
+  cmGenerateProfile* GenerateProfile;
   std::string GraphVizFile;
   InstalledFilesMap InstalledFiles;
 
@@ -20,6 +20,7 @@
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
 # include "cmDependsFortran.h" // For -E cmake_copy_f90_mod callback.
+# include "cmGlobalNinjaGenerator.h" // For -E cmake_ninja_fortran_scan.
 #endif
 
 #include <cmsys/Directory.hxx>
@@ -1063,6 +1064,11 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       {
       return cmDependsFortran::CopyModule(args)? 0 : 1;
       }
+    else if (args[1] == "cmake_ninja_fortran_scan" && args.size() == 4)
+      {
+      return cmGlobalNinjaGenerator::ScanFortranModules(args[2], args[3])?
+        0 : 1;
+      }
 #endif
 
 #if defined(_WIN32) && !defined(__CYGWIN__)
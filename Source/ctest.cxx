@@ -55,6 +55,9 @@ static const char * cmDocumentationOptions[][2] =
    "given number of jobs."},
   {"-Q,--quiet", "Make ctest quiet."},
   {"-O <file>, --output-log <file>", "Output to log file"},
+  {"--output-jsonl <file>", "Write one JSON line per test as tests "
+   "complete"},
+  {"--output-junit <file>", "Write test results in JUnit XML format"},
   {"-N,--show-only", "Disable actual execution of tests."},
   {"-L <regex>, --label-regex <regex>", "Run tests with labels matching "
    "regular expression."},
@@ -79,6 +82,12 @@ static const char * cmDocumentationOptions[][2] =
    "Run a specific number of tests by number."},
   {"-U, --union", "Take the Union of -I and -R"},
   {"--rerun-failed", "Run only the tests that failed previously"},
+  {"--changed-files <file>", "Run only the tests affected by the source "
+   "files listed in <file>"},
+  {"--explain-selection", "Print why each test was selected by "
+   "--changed-files"},
+  {"--shard <index>/<count>", "Run only the tests of one shard out of "
+   "<count> shards balanced by cost"},
   {"--repeat-until-fail <n>", "Require each test to run <n> "
    "times without failing in order to pass"},
   {"--max-width <width>", "Set the max width for a test name to output"},
@@ -103,6 +112,8 @@ static const char * cmDocumentationOptions[][2] =
   {"--test-command", "The test to run with the --build-and-test option."},
   {"--test-timeout", "The time limit in seconds, internal use only."},
   {"--test-load", "CPU load threshold for starting new parallel tests."},
+  {"--resource-pools <pool>=<count>[;<pool>=<count>...]",
+   "Capacity of resource pools used by the RESOURCE_POOLS test property."},
   {"--tomorrow-tag", "Nightly or experimental starts with next day tag."},
   {"--ctest-config", "The configuration file used to initialize CTest state "
    "when submitting dashboards."},
@@ -110,6 +121,12 @@ static const char * cmDocumentationOptions[][2] =
   {"--extra-submit <file>[;<file>]", "Submit extra files to the dashboard."},
   {"--force-new-ctest-process", "Run child CTest instances as new processes"},
   {"--schedule-random", "Use a random order for scheduling tests"},
+  {"--schedule-critical-path", "Start tests gating the longest chain of "
+   "dependent tests first"},
+  {"--schedule-cpu-time", "Order parallel tests by their recorded CPU "
+   "time"},
+  {"--schedule-report", "Print the predicted and achieved test schedule "
+   "length"},
   {"--submit-index", "Submit individual dashboard tests with specific index"},
   {"--timeout <seconds>", "Set a global timeout on all tests."},
   {"--stop-time <time>",
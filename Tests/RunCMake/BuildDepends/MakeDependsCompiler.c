@@ -0,0 +1,4 @@
+/* The header is named by a macro so only the compiler finds it.  */
+#define HEADER <MakeDependsCompiler.h>
+#include HEADER
+int main(void) { return MAIN_RESULT; }
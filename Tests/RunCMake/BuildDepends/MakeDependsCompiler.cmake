@@ -0,0 +1,13 @@
+enable_language(C)
+set(CMAKE_DEPENDS_USE_COMPILER 1)
+include_directories(${CMAKE_CURRENT_BINARY_DIR})
+add_executable(main MakeDependsCompiler.c)
+
+file(GENERATE OUTPUT check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+  \"$<TARGET_FILE:main>|${CMAKE_CURRENT_BINARY_DIR}/MakeDependsCompiler.h\"
+  )
+set(check_exes
+  \"$<TARGET_FILE:main>\"
+  )
+")
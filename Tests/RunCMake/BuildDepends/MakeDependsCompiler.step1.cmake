@@ -0,0 +1,3 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeDependsCompiler.h" [[
+#define MAIN_RESULT 1
+]])
@@ -0,0 +1,3 @@
+if(actual_stdout MATCHES "Configuring done")
+  set(RunCMake_TEST_FAILED "CMake re-ran although no list file was modified.")
+endif()
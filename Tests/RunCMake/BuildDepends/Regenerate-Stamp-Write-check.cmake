@@ -0,0 +1,3 @@
+if(NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake.stamp")
+  set(RunCMake_TEST_FAILED "Build system stamp was not written.")
+endif()
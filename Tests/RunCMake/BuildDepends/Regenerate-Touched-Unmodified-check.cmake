@@ -0,0 +1,7 @@
+if(actual_stdout MATCHES "Configuring done")
+  set(RunCMake_TEST_FAILED "CMake re-ran although no list file was modified.")
+elseif(NOT "${RunCMake_TEST_BINARY_DIR}/Makefile" IS_NEWER_THAN
+       "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt")
+  set(RunCMake_TEST_FAILED
+    "Build system not brought up to date with the touched list file.")
+endif()
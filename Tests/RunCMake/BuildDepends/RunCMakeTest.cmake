@@ -48,6 +48,11 @@ if(RunCMake_GENERATOR MATCHES "Make" AND
   run_BuildDepends(MakeInProjectOnly)
 endif()
 
+if(RunCMake_GENERATOR MATCHES "Make" AND
+   CMAKE_C_COMPILER_ID MATCHES "GNU|Clang")
+  run_BuildDepends(MakeDependsCompiler)
+endif()
+
 function(run_ReGeneration)
   # test re-generation of project even if CMakeLists.txt files disappeared
 
@@ -86,3 +91,92 @@ endfunction()
 if(RunCMake_GENERATOR STREQUAL "Xcode")
   run_ReGeneration(regenerate-project)
 endif()
+
+function(run_ReGenerationTouched)
+  # test that touching a list file without modifying it does not
+  # re-run cmake while a real modification does
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/regenerate-touched-build)
+  set(RunCMake_TEST_SOURCE_DIR ${RunCMake_BINARY_DIR}/regenerate-touched-source)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(REMOVE_RECURSE "${RunCMake_TEST_SOURCE_DIR}")
+  file(WRITE "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt" [=[
+    cmake_minimum_required(VERSION 3.5)
+    project(Regenerate-Touched NONE)
+  ]=])
+
+  run_cmake(Regenerate-Touched)
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay})
+  execute_process(COMMAND ${CMAKE_COMMAND} -E touch
+    "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt")
+  run_cmake_command(Regenerate-Touched-Unmodified
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay})
+  file(APPEND "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt" "# modified\n")
+  run_cmake_command(Regenerate-Touched-Modified
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+endfunction()
+
+if(RunCMake_GENERATOR MATCHES "Make")
+  run_ReGenerationTouched()
+endif()
+
+function(run_ReGenerationStamp)
+  # test that a build system found up to date is stamped and that the
+  # stamp does not hide a later modification
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/regenerate-stamp-build)
+  set(RunCMake_TEST_SOURCE_DIR ${RunCMake_BINARY_DIR}/regenerate-stamp-source)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(REMOVE_RECURSE "${RunCMake_TEST_SOURCE_DIR}")
+  file(WRITE "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt" [=[
+    cmake_minimum_required(VERSION 3.5)
+    project(Regenerate-Stamp NONE)
+  ]=])
+
+  run_cmake(Regenerate-Stamp)
+
+  # Files modified within the last second are not stamped.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 2.25)
+  run_cmake_command(Regenerate-Stamp-Write
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake_command(Regenerate-Stamp-Unmodified
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay})
+  file(APPEND "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt" "# modified\n")
+  run_cmake_command(Regenerate-Stamp-Modified
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+endfunction()
+
+if(RunCMake_GENERATOR MATCHES "Make")
+  run_ReGenerationStamp()
+endif()
+
+function(run_ReGenerationFailed)
+  # test that a failed re-run of cmake does not leave a build system
+  # that later builds consider up to date
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/regenerate-failed-build)
+  set(RunCMake_TEST_SOURCE_DIR ${RunCMake_BINARY_DIR}/regenerate-failed-source)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(REMOVE_RECURSE "${RunCMake_TEST_SOURCE_DIR}")
+  file(WRITE "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt" [=[
+    cmake_minimum_required(VERSION 3.5)
+    project(Regenerate-Failed NONE)
+  ]=])
+
+  run_cmake(Regenerate-Failed)
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${fs_delay})
+  file(APPEND "${RunCMake_TEST_SOURCE_DIR}/CMakeLists.txt"
+    "message(FATAL_ERROR \"Regenerate-Failed error\")\n")
+  run_cmake_command(Regenerate-Failed-First
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake_command(Regenerate-Failed-Again
+    ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}")
+endfunction()
+
+if(RunCMake_GENERATOR MATCHES "Make")
+  run_ReGenerationFailed()
+endif()
@@ -0,0 +1,17 @@
+set(jsonl_file "${RunCMake_TEST_BINARY_DIR}/results.jsonl")
+set(junit_file "${RunCMake_TEST_BINARY_DIR}/junit.xml")
+if(NOT EXISTS "${jsonl_file}")
+  set(RunCMake_TEST_FAILED "JSON lines file not found:\n ${jsonl_file}")
+elseif(NOT EXISTS "${junit_file}")
+  set(RunCMake_TEST_FAILED "JUnit file not found:\n ${junit_file}")
+elseif(EXISTS "${junit_file}.cases")
+  set(RunCMake_TEST_FAILED "JUnit test cases file not removed")
+else()
+  file(STRINGS "${jsonl_file}" jsonl)
+  file(READ "${junit_file}" junit)
+  if(NOT jsonl MATCHES [[^{[^;]*"labels":\["A","B"\],"name":"Pass","output":"<pass>\\n".*"status":"passed"};{[^;]*"name":"Fail".*"status":"failed"}$]])
+    set(RunCMake_TEST_FAILED "JSON lines do not match:\n ${jsonl}")
+  elseif(NOT junit MATCHES [[<testsuite name="ctest" tests="2" failures="1" skipped="0" time="[^"]*">.*<testcase name="Pass".*&lt;pass&gt;.*<testcase name="Fail"[^>]*>[^<]*<failure message="Failed"/>]])
+    set(RunCMake_TEST_FAILED "JUnit file does not match:\n ${junit}")
+  endif()
+endif()
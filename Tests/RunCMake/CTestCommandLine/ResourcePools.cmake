@@ -0,0 +1,6 @@
+if(EXISTS "${LOCK}")
+  message(FATAL_ERROR "Another test is using the resource pool.")
+endif()
+file(WRITE "${LOCK}" "")
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 0.5)
+file(REMOVE "${LOCK}")
@@ -0,0 +1,23 @@
+file(GLOB test_xml_file "${RunCMake_TEST_BINARY_DIR}/Testing/*/Test.xml")
+set(usage_file "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/CTestResourceUsage.json")
+set(cost_file "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/CTestCostData.txt")
+if(NOT test_xml_file)
+  set(RunCMake_TEST_FAILED "Test.xml not found")
+elseif(NOT EXISTS "${usage_file}")
+  set(RunCMake_TEST_FAILED "Resource usage summary not found:\n ${usage_file}")
+else()
+  file(READ "${test_xml_file}" test_xml)
+  file(READ "${usage_file}" usage)
+  file(STRINGS "${cost_file}" cost_lines REGEX "^Usage ")
+  if(NOT "${usage}" MATCHES [["name" : "Usage"]])
+    set(RunCMake_TEST_FAILED "Resource usage summary does not list the test:\n ${usage}")
+  elseif(NOT WIN32)
+    if(NOT "${test_xml}" MATCHES [[name="CPU Time".*name="Peak Memory \(KiB\)"]])
+      set(RunCMake_TEST_FAILED "Test.xml does not report resource usage:\n ${test_xml}")
+    elseif(NOT "${usage}" MATCHES "\"peakMemoryKiB\" : [1-9]")
+      set(RunCMake_TEST_FAILED "Resource usage summary has no peak memory:\n ${usage}")
+    elseif(NOT cost_lines MATCHES "^Usage 1 [0-9.e-]+ 1 [0-9.e-]+$")
+      set(RunCMake_TEST_FAILED "Cost data does not record CPU time:\n ${cost_lines}")
+    endif()
+  endif()
+endif()
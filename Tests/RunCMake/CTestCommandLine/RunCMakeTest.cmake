@@ -140,3 +140,172 @@ function(run_TestOutputSize)
     )
 endfunction()
 run_TestOutputSize()
+
+function(run_ScheduleCriticalPath)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ScheduleCriticalPath)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(Short1 \"${CMAKE_COMMAND}\" -E echo Short1)
+add_test(Short2 \"${CMAKE_COMMAND}\" -E echo Short2)
+add_test(Gate \"${CMAKE_COMMAND}\" -E echo Gate)
+add_test(Long \"${CMAKE_COMMAND}\" -E echo Long)
+set_tests_properties(Short2 PROPERTIES DEPENDS Short1)
+set_tests_properties(Long PROPERTIES DEPENDS Gate)
+")
+  # Durations recorded by a previous run.  Both chains have the same
+  # depth but only the one through Long is critical.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/CTestCostData.txt"
+"Short1 1 1
+Short2 1 1
+Gate 1 1
+Long 1 10
+---
+")
+  run_cmake_command(ScheduleCriticalPath
+    ${CMAKE_CTEST_COMMAND} -j2 --schedule-critical-path --schedule-report
+    )
+endfunction()
+run_ScheduleCriticalPath()
+
+function(run_ResourcePools)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ResourcePools)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  # Each test fails if another test holding the pool is running.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+foreach(t Pool1 Pool2 Pool3)
+  add_test(\${t} \"${CMAKE_COMMAND}\"
+    -DLOCK=${RunCMake_TEST_BINARY_DIR}/lock
+    -P \"${RunCMake_SOURCE_DIR}/ResourcePools.cmake\")
+endforeach()
+set_tests_properties(Pool1 Pool2 PROPERTIES RESOURCE_POOLS memory_gb=3)
+set_tests_properties(Pool3 PROPERTIES RESOURCE_POOLS memory_gb=8)
+")
+  run_cmake_command(ResourcePools
+    ${CMAKE_CTEST_COMMAND} -j3 --resource-pools memory_gb=4
+    )
+endfunction()
+run_ResourcePools()
+
+function(run_TestOutputSpill)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/TestOutputSpill)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(LargeOutput \"${CMAKE_COMMAND}\" -P \"${RunCMake_SOURCE_DIR}/TestOutputSpill.cmake\")
+set_tests_properties(LargeOutput PROPERTIES FAIL_REGULAR_EXPRESSION \"MIDDLE-ERROR\")
+")
+  run_cmake_command(TestOutputSpill
+    ${CMAKE_CTEST_COMMAND} -M Experimental -T Test --no-compress-output
+                           --test-output-size-failed 4000
+    )
+endfunction()
+run_TestOutputSpill()
+
+function(run_TestOutputSpillCompressed)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/TestOutputSpillCompressed)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(LargeOutput \"${CMAKE_COMMAND}\" -P \"${RunCMake_SOURCE_DIR}/TestOutputSpill.cmake\")
+set_tests_properties(LargeOutput PROPERTIES FAIL_REGULAR_EXPRESSION \"MIDDLE-ERROR\")
+")
+  # Test output is compressed only for a dashboard server that accepts it.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/DartConfiguration.tcl" "
+CDashVersion: 1.6
+")
+  run_cmake_command(TestOutputSpillCompressed
+    ${CMAKE_CTEST_COMMAND} -M Experimental -T Test
+                           --test-output-size-failed 4000
+    )
+endfunction()
+run_TestOutputSpillCompressed()
+
+function(run_ResourceUsage)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ResourceUsage)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(Usage \"${CMAKE_COMMAND}\" -E echo Usage)
+")
+  run_cmake_command(ResourceUsage
+    ${CMAKE_CTEST_COMMAND} -M Experimental -T Test
+    )
+endfunction()
+run_ResourceUsage()
+
+function(run_OutputStreams)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/OutputStreams)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(Pass \"${CMAKE_COMMAND}\" -E echo \"<pass>\")
+add_test(Fail \"${CMAKE_COMMAND}\" -E false)
+set_tests_properties(Pass PROPERTIES LABELS \"A;B\")
+")
+  run_cmake_command(OutputStreams
+    ${CMAKE_CTEST_COMMAND} --output-jsonl results.jsonl
+                           --output-junit junit.xml
+    )
+endfunction()
+run_OutputStreams()
+
+function(run_Shard name shard)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/${name})
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(Big \"${CMAKE_COMMAND}\" -E echo Big)
+add_test(Small1 \"${CMAKE_COMMAND}\" -E echo Small1)
+add_test(Small2 \"${CMAKE_COMMAND}\" -E echo Small2)
+add_test(Lock1 \"${CMAKE_COMMAND}\" -E echo Lock1)
+add_test(Lock2 \"${CMAKE_COMMAND}\" -E echo Lock2)
+add_test(Free \"${CMAKE_COMMAND}\" -E echo Free)
+set_tests_properties(Small2 PROPERTIES DEPENDS Small1)
+set_tests_properties(Lock1 Lock2 PROPERTIES RESOURCE_LOCK db)
+set_tests_properties(Big PROPERTIES COST 10)
+")
+  # Durations recorded by a previous run.  The groups cost Big 10,
+  # Lock1+Lock2 6, Small1+Small2 4 and Free 1.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/CTestCostData.txt"
+"Small1 1 2
+Small2 1 2
+Lock1 1 3
+Lock2 1 3
+Free 1 1
+---
+")
+  run_cmake_command(${name} ${CMAKE_CTEST_COMMAND} -N --shard ${shard})
+endfunction()
+run_Shard(Shard1 1/2)
+run_Shard(Shard2 2/2)
+run_Shard(ShardInvalid 3/2)
+
+function(run_TestImpact)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/TestImpact-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(TestImpact)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/changed.txt"
+    "${RunCMake_TEST_BINARY_DIR}/base.c\n")
+  run_cmake_command(TestImpact-base ${CMAKE_CTEST_COMMAND} -N
+    --changed-files changed.txt --explain-selection)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/changed.txt"
+    "${RunCMake_TEST_BINARY_DIR}/other.c\n")
+  run_cmake_command(TestImpact-other ${CMAKE_CTEST_COMMAND} -N
+    --changed-files changed.txt)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/changed.txt"
+    "${RunCMake_TEST_BINARY_DIR}/base.h\n")
+  run_cmake_command(TestImpact-header ${CMAKE_CTEST_COMMAND} -N
+    --changed-files changed.txt --explain-selection)
+endfunction()
+run_TestImpact()
@@ -0,0 +1,9 @@
+set(manifest_file "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/CTestShardManifest.json")
+if(NOT EXISTS "${manifest_file}")
+  set(RunCMake_TEST_FAILED "Shard manifest not found:\n ${manifest_file}")
+else()
+  file(READ "${manifest_file}" manifest)
+  if(NOT manifest MATCHES [=["index" : 1,[^]]*"tests" : \[ "Big", "Free" \].*"index" : 2,[^]]*"tests" : \[ "Small1", "Small2", "Lock1", "Lock2" \]]=])
+    set(RunCMake_TEST_FAILED "Shard manifest does not match:\n ${manifest}")
+  endif()
+endif()
@@ -0,0 +1,17 @@
+enable_language(C)
+enable_testing()
+foreach(name base lib app other)
+  file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/${name}.c" "int ${name}(void) { return 0; }\n")
+endforeach()
+# A header that is not listed as a source of any target.
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/base.h" "int base(void);\n")
+add_library(base STATIC base.c)
+add_library(lib STATIC lib.c)
+target_link_libraries(lib base)
+add_executable(app app.c)
+target_link_libraries(app lib)
+add_executable(other other.c)
+add_test(NAME AppTest COMMAND app)
+add_test(NAME OtherTest COMMAND other)
+add_test(NAME GenexTest COMMAND ${CMAKE_COMMAND} -E echo $<TARGET_FILE:app>)
+add_test(NAME ScriptTest COMMAND ${CMAKE_COMMAND} -E echo hi)
@@ -0,0 +1,17 @@
+file(GLOB test_xml_file "${RunCMake_TEST_BINARY_DIR}/Testing/*/Test.xml")
+set(spill_file "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/TestOutput_1.log")
+if(NOT test_xml_file)
+  set(RunCMake_TEST_FAILED "Test.xml not found")
+elseif(NOT EXISTS "${spill_file}")
+  set(RunCMake_TEST_FAILED "Full test output not found:\n ${spill_file}")
+else()
+  file(READ "${test_xml_file}" test_xml)
+  file(STRINGS "${spill_file}" spill_lines REGEX "MIDDLE-ERROR|line 20000 ")
+  if(NOT "${test_xml}" MATCHES [[<Test Status="failed">.*Error regular expression found]])
+    set(RunCMake_TEST_FAILED "Test.xml does not fail on the removed output:\n ${test_xml}")
+  elseif(NOT "${test_xml}" MATCHES [[<Value>output line 1 of.*The middle of the test output was removed.*output line 20000 of[^<]*</Value>]])
+    set(RunCMake_TEST_FAILED "Test.xml does not keep the head and tail of the output:\n ${test_xml}")
+  elseif(NOT spill_lines MATCHES "MIDDLE-ERROR;.*line 20000 ")
+    set(RunCMake_TEST_FAILED "Full test output is incomplete:\n ${spill_lines}")
+  endif()
+endif()
@@ -0,0 +1,7 @@
+# Print more than the one MiB ctest keeps in memory for a test.
+foreach(i RANGE 1 20000)
+  if(i EQUAL 10000)
+    message("MIDDLE-ERROR")
+  endif()
+  message("output line ${i} of the test that prints a lot of lines")
+endforeach()
@@ -0,0 +1,20 @@
+file(GLOB test_xml_file "${RunCMake_TEST_BINARY_DIR}/Testing/*/Test.xml")
+set(spill_file "${RunCMake_TEST_BINARY_DIR}/Testing/Temporary/TestOutput_1.log")
+if(NOT test_xml_file)
+  set(RunCMake_TEST_FAILED "Test.xml not found")
+elseif(NOT EXISTS "${spill_file}")
+  set(RunCMake_TEST_FAILED "Full test output not found:\n ${spill_file}")
+else()
+  file(READ "${test_xml_file}" test_xml)
+  # Only the head and tail kept within the 4000 byte limit are compressed.
+  if(NOT "${test_xml}" MATCHES [[<Value encoding="base64" compression="gzip">([^<]*)</Value>]])
+    set(RunCMake_TEST_FAILED "Test.xml does not have compressed output:\n ${test_xml}")
+  else()
+    string(LENGTH "${CMAKE_MATCH_1}" encoded_length)
+    if(encoded_length GREATER 8000)
+      set(RunCMake_TEST_FAILED "Test.xml has ${encoded_length} bytes of compressed output, more than the kept output.")
+    elseif(NOT "${test_xml}" MATCHES [[<Test Status="failed">.*Error regular expression found]])
+      set(RunCMake_TEST_FAILED "Test.xml does not fail on the removed output:\n ${test_xml}")
+    endif()
+  endif()
+endif()
@@ -264,6 +264,31 @@ set(RunCMake_TEST_OPTIONS --trace-expand)
 run_cmake(trace-expand)
 unset(RunCMake_TEST_OPTIONS)
 
+function(run_trace_cache)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/trace-cache-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(RunCMake_TEST_OPTIONS --trace)
+  run_cmake(trace-cache)
+  run_cmake_command(trace-cache-rerun ${CMAKE_COMMAND} . --trace)
+endfunction()
+run_trace_cache()
+
+set(RunCMake_TEST_OPTIONS --trace)
+run_cmake(trace-genex)
+unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_OPTIONS
+  --profiling-output=${RunCMake_BINARY_DIR}/profiling-output-build/trace.json)
+run_cmake(profiling-output)
+unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_OPTIONS
+  --generate-profile=${RunCMake_BINARY_DIR}/generate-profile-build/profile.json)
+run_cmake(generate-profile)
+unset(RunCMake_TEST_OPTIONS)
+
 set(RunCMake_TEST_OPTIONS --debug-trycompile)
 run_cmake(debug-trycompile)
 unset(RunCMake_TEST_OPTIONS)
@@ -11,3 +11,14 @@ CMakeFiles/DepTarget.dir/test.c.o: .*/Tests/RunCMake/CommandLine/cmake_depends/t
 else()
   set(RunCMake_TEST_FAILED "depend.make missing:\n ${depend_make}")
 endif()
+
+file(GLOB include_cache "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/IncludeCache/C-*.includecache")
+if(include_cache)
+  file(READ "${include_cache}" include_cache_content)
+  if(NOT include_cache_content MATCHES "/cmake_depends/test.c\n[0-9]+\ntest.h\n[^\n]*/cmake_depends/test.h\n")
+    string(REPLACE "\n" "\n  " include_cache_content "  ${include_cache_content}")
+    set(RunCMake_TEST_FAILED "${RunCMake_TEST_FAILED}\nshared include cache does not have expected content:\n${include_cache_content}")
+  endif()
+else()
+  set(RunCMake_TEST_FAILED "${RunCMake_TEST_FAILED}\nshared include cache missing")
+endif()
@@ -0,0 +1,23 @@
+set(profile "${RunCMake_TEST_BINARY_DIR}/profile.json")
+if(NOT EXISTS "${profile}")
+  set(RunCMake_TEST_FAILED "Generate profile not written:\n  ${profile}")
+  return()
+endif()
+file(READ "${profile}" content)
+set(phases "")
+foreach(phase
+    Compute
+    FinalizeTargetCompileInfo
+    CreateQtAutoGeneratorsTargets
+    ComputeTargetDepends
+    Generate
+    LocalGenerator::Generate
+    WriteSummary
+    )
+  set(phases "${phases}.*\"name\" : \"${phase}\"")
+endforeach()
+if(NOT content MATCHES "${phases}")
+  set(RunCMake_TEST_FAILED "Generate profile does not list all phases:\n  ${profile}")
+elseif(NOT content MATCHES "\"seconds\" : [0-9]")
+  set(RunCMake_TEST_FAILED "Generate profile does not list durations:\n  ${profile}")
+endif()
@@ -0,0 +1 @@
+add_custom_target(generate-profile ALL)
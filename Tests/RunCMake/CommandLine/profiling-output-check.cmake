@@ -0,0 +1,12 @@
+set(trace "${RunCMake_TEST_BINARY_DIR}/trace.json")
+if(NOT EXISTS "${trace}")
+  set(RunCMake_TEST_FAILED "Profiling output not written:\n  ${trace}")
+  return()
+endif()
+file(READ "${trace}" content)
+if(NOT content MATCHES "^\\[\n{.*}\n\\]\n$")
+  set(RunCMake_TEST_FAILED "Profiling output is not a JSON array:\n  ${trace}")
+elseif(NOT content MATCHES
+    "\"name\":\"profiled_function\",\"ph\":\"B\".*\"name\":\"include\",\"ph\":\"B\".*\"cat\":\"listfile\",\"name\":\"[^\"]*/profiling-output-include.cmake\",\"ph\":\"B\".*\"name\":\"set\",\"ph\":\"B\"")
+  set(RunCMake_TEST_FAILED "Profiling output does not nest the calls:\n  ${trace}")
+endif()
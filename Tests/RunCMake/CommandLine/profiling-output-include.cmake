@@ -0,0 +1 @@
+set(profiled_variable 1)
@@ -0,0 +1,4 @@
+function(profiled_function)
+  include(${CMAKE_CURRENT_LIST_DIR}/profiling-output-include.cmake)
+endfunction()
+profiled_function()
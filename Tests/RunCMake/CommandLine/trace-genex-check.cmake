@@ -0,0 +1,4 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/trace-genex.txt" content)
+if(NOT content STREQUAL "DEF;DEF")
+  set(RunCMake_TEST_FAILED "trace-genex.txt has unexpected content:\n  ${content}")
+endif()
@@ -0,0 +1,4 @@
+add_library(iface INTERFACE)
+set_property(TARGET iface PROPERTY INTERFACE_COMPILE_DEFINITIONS "$<1:DEF>")
+file(GENERATE OUTPUT trace-genex.txt CONTENT
+  "$<TARGET_PROPERTY:iface,INTERFACE_COMPILE_DEFINITIONS>;$<TARGET_PROPERTY:iface,INTERFACE_COMPILE_DEFINITIONS>")
@@ -0,0 +1,4 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/build.ninja" build_ninja)
+if(NOT build_ninja MATCHES "build CMakeFiles/gen_user.dir/FortranModules/gen_user.f90.o: [^\n]* \\| CMakeFiles/gen_provider.dir/gen_provider.f90.o")
+  set(RunCMake_TEST_FAILED "The user of a generated module does not depend on its provider object.")
+endif()
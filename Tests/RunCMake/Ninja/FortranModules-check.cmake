@@ -0,0 +1,6 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/build.ninja" build_ninja)
+if(NOT build_ninja MATCHES "build CMakeFiles/user.dir/FortranModules/user.f90.o: [^\n]* \\| CMakeFiles/provider.dir/FortranModules/provider.f90.o")
+  set(RunCMake_TEST_FAILED "The user object does not depend on the provider object.")
+elseif(NOT build_ninja MATCHES "build CMakeFiles/FortranModules.txt: FORTRAN_MODULE_SCAN [^\n]* \\| [^\n]*gen_provider.f90")
+  set(RunCMake_TEST_FAILED "The generated source is not scanned after it is generated.")
+endif()
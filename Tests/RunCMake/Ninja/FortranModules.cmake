@@ -0,0 +1,17 @@
+enable_language(Fortran)
+
+# The user library comes first and does not depend on the provider
+# library, so only the module dependency orders the compilation.
+add_library(user STATIC FortranModules/user.f90)
+add_library(provider STATIC FortranModules/provider.f90)
+
+# A provider generated during the build is scanned once it exists.
+add_custom_command(
+  OUTPUT gen_provider.f90
+  COMMAND ${CMAKE_COMMAND} -E copy
+    ${CMAKE_CURRENT_SOURCE_DIR}/FortranModules/gen_provider.f90.in
+    gen_provider.f90
+  DEPENDS FortranModules/gen_provider.f90.in
+  )
+add_library(gen_user STATIC FortranModules/gen_user.f90)
+add_library(gen_provider STATIC ${CMAKE_CURRENT_BINARY_DIR}/gen_provider.f90)
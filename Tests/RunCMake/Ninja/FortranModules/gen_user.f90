@@ -0,0 +1,4 @@
+subroutine gen_user
+  use generated
+  call gen_hello()
+end subroutine gen_user
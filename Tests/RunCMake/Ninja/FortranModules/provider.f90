@@ -0,0 +1,5 @@
+module provided
+contains
+  subroutine hello()
+  end subroutine hello
+end module provided
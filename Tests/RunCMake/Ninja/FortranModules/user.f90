@@ -0,0 +1,4 @@
+subroutine user
+  use provided
+  call hello()
+end subroutine user
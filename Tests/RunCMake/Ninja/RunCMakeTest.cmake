@@ -32,3 +32,19 @@ function(run_SubDir)
   run_cmake_command(SubDir-build ${CMAKE_COMMAND} --build . --target ${SubDir_all})
 endfunction()
 run_SubDir()
+
+function(run_FortranModules)
+  # Use a single build tree for a few tests without cleaning.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/FortranModules-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_OPTIONS
+    -DCMAKE_Fortran_COMPILER=${CMAKE_Fortran_COMPILER})
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(FortranModules)
+  unset(RunCMake_TEST_OPTIONS)
+  run_cmake_command(FortranModules-build ${CMAKE_COMMAND} --build .)
+endfunction()
+if(CMAKE_Fortran_COMPILER)
+  run_FortranModules()
+endif()
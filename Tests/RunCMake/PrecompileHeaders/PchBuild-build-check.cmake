@@ -0,0 +1,10 @@
+foreach(pch cmake_pch.h cmake_pch.hxx)
+  file(GLOB files "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/base.dir/${pch}.*")
+  if(NOT files)
+    set(RunCMake_TEST_FAILED "No precompiled header built from ${pch}.")
+    return()
+  endif()
+endforeach()
+if(EXISTS "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/app.dir/cmake_pch.hxx")
+  set(RunCMake_TEST_FAILED "Target app wrote its own precompiled header.")
+endif()
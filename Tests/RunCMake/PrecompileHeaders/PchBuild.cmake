@@ -0,0 +1,13 @@
+enable_language(C)
+enable_language(CXX)
+
+add_library(base STATIC PchBuild/base.cxx PchBuild/lib.c)
+set_property(TARGET base PROPERTY PRECOMPILE_HEADERS
+  PchBuild/pch.h "$<$<COMPILE_LANGUAGE:CXX>:<vector$<ANGLE-R>>")
+
+# The application uses the precompiled header of the library except in
+# one source that must not see it.
+add_executable(app PchBuild/main.cxx PchBuild/skipped.cxx)
+set_property(TARGET app PROPERTY PRECOMPILE_HEADERS_REUSE_FROM base)
+set_property(SOURCE PchBuild/skipped.cxx PROPERTY SKIP_PRECOMPILE_HEADERS 1)
+target_link_libraries(app base)
@@ -0,0 +1,4 @@
+#ifndef PCH_INCLUDED
+# error "precompiled header not used"
+#endif
+int base() { return static_cast<int>(std::vector<int>().size()); }
@@ -0,0 +1,11 @@
+#ifndef PCH_INCLUDED
+# error "precompiled header not used"
+#endif
+extern "C" int lib(void);
+int base();
+int skipped();
+int main()
+{
+  std::vector<int> v(1, lib() + base() + skipped());
+  return v[0];
+}
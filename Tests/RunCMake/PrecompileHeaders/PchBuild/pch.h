@@ -0,0 +1 @@
+#define PCH_INCLUDED 1
@@ -0,0 +1,4 @@
+#ifdef PCH_INCLUDED
+# error "precompiled header used"
+#endif
+int skipped() { return 0; }
@@ -0,0 +1,9 @@
+set(unity "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/app.dir/Unity/unity_0_c.c")
+if(NOT EXISTS "${unity}")
+  set(RunCMake_TEST_FAILED "Unity source not generated.")
+  return()
+endif()
+file(READ "${unity}" content)
+if(NOT content MATCHES "main.c.*a.c.*b.c" OR content MATCHES "skipped.c")
+  set(RunCMake_TEST_FAILED "Unexpected unity source:\n${content}")
+endif()
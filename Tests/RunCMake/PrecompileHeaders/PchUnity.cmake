@@ -0,0 +1,11 @@
+enable_language(C)
+
+# The unity source is compiled with the precompiled header, so the source
+# that must not see it is compiled on its own.
+add_executable(app PchUnity/main.c PchUnity/a.c PchUnity/skipped.c
+  PchUnity/b.c)
+set_target_properties(app PROPERTIES
+  PRECOMPILE_HEADERS PchUnity/pch.h
+  UNITY_BUILD ON
+  )
+set_property(SOURCE PchUnity/skipped.c PROPERTY SKIP_PRECOMPILE_HEADERS 1)
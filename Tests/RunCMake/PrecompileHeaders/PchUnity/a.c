@@ -0,0 +1,4 @@
+#ifndef PCH_INCLUDED
+# error "precompiled header not used"
+#endif
+int a(void) { return 0; }
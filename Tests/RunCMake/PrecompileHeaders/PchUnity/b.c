@@ -0,0 +1,4 @@
+#ifndef PCH_INCLUDED
+# error "precompiled header not used"
+#endif
+int b(void) { return 0; }
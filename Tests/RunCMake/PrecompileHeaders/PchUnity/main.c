@@ -0,0 +1,10 @@
+#ifndef PCH_INCLUDED
+# error "precompiled header not used"
+#endif
+int a(void);
+int b(void);
+int skipped(void);
+int main(void)
+{
+  return a() + b() + skipped();
+}
@@ -0,0 +1,6 @@
+enable_language(C)
+enable_language(CXX)
+add_library(base STATIC empty.c)
+set_property(TARGET base PROPERTY PRECOMPILE_HEADERS PchBuild/pch.h)
+add_library(foo STATIC empty.cxx)
+set_property(TARGET foo PROPERTY PRECOMPILE_HEADERS_REUSE_FROM base)
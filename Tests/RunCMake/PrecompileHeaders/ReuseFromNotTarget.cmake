@@ -0,0 +1,3 @@
+enable_language(C)
+add_library(foo STATIC empty.c)
+set_property(TARGET foo PROPERTY PRECOMPILE_HEADERS_REUSE_FROM nothere)
@@ -0,0 +1,6 @@
+enable_language(C)
+add_library(base STATIC empty.c)
+set_property(TARGET base PROPERTY PRECOMPILE_HEADERS PchBuild/pch.h)
+add_library(foo STATIC empty.c)
+target_compile_definitions(foo PRIVATE FOO)
+set_property(TARGET foo PROPERTY PRECOMPILE_HEADERS_REUSE_FROM base)
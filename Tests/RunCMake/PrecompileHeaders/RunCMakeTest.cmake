@@ -0,0 +1,30 @@
+include(RunCMake)
+
+run_cmake(ReuseFromNotTarget)
+
+function(run_PchBuild)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/PchBuild-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(PchBuild)
+  run_cmake_command(PchBuild-build ${CMAKE_COMMAND} --build .)
+  run_cmake_command(PchBuild-run ${RunCMake_TEST_BINARY_DIR}/app)
+endfunction()
+
+function(run_PchUnity)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/PchUnity-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(PchUnity)
+  run_cmake_command(PchUnity-build ${CMAKE_COMMAND} --build .)
+  run_cmake_command(PchUnity-run ${RunCMake_TEST_BINARY_DIR}/app)
+endfunction()
+if(RunCMake_GENERATOR MATCHES "Make|Ninja" AND
+   CMAKE_C_COMPILER_ID MATCHES "GNU|Clang")
+  run_cmake(ReuseFromLanguage)
+  run_cmake(ReuseFromOptions)
+  run_PchBuild()
+  run_PchUnity()
+endif()
@@ -0,0 +1,3 @@
+enable_language(C)
+add_library(foo STATIC UnityBuild/a.c UnityBuild/b.c)
+set_target_properties(foo PROPERTIES UNITY_BUILD ON UNITY_BUILD_BATCH_SIZE -1)
@@ -0,0 +1,17 @@
+include(RunCMake)
+
+run_cmake(BadBatchSize)
+run_cmake(UnityBuildType)
+
+function(run_UnityBuild)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/UnityBuild-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(UnityBuild)
+  run_cmake_command(UnityBuild-build ${CMAKE_COMMAND} --build .)
+  run_cmake_command(UnityBuild-run ${RunCMake_TEST_BINARY_DIR}/app)
+endfunction()
+if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+  run_UnityBuild()
+endif()
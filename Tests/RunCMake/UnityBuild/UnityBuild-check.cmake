@@ -0,0 +1,22 @@
+set(unity_dir "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/app.dir/Unity")
+foreach(check
+    "unity_0_c.c|main.c.*a.c"
+    "unity_1_c.c|b.c"
+    )
+  string(REPLACE "|" ";" check "${check}")
+  list(GET check 0 file)
+  list(GET check 1 expect)
+  if(NOT EXISTS "${unity_dir}/${file}")
+    set(RunCMake_TEST_FAILED "Unity source ${file} not generated.")
+    return()
+  endif()
+  file(READ "${unity_dir}/${file}" content)
+  if(NOT content MATCHES "${expect}" OR content MATCHES "own.c")
+    set(RunCMake_TEST_FAILED
+      "Unity source ${file} does not include ${expect}:\n${content}")
+    return()
+  endif()
+endforeach()
+if(EXISTS "${unity_dir}/unity_2_c.c")
+  set(RunCMake_TEST_FAILED "Too many unity sources generated.")
+endif()
@@ -0,0 +1,9 @@
+enable_language(C)
+
+set(CMAKE_UNITY_BUILD ON)
+set(CMAKE_UNITY_BUILD_BATCH_SIZE 2)
+add_executable(app UnityBuild/main.c UnityBuild/a.c UnityBuild/b.c
+  UnityBuild/own.c)
+
+# Both files define the same static function.
+set_property(SOURCE UnityBuild/own.c PROPERTY SKIP_UNITY_BUILD_INCLUSION 1)
@@ -0,0 +1,7 @@
+int a(void);
+int b(void);
+int own(void);
+int main(void)
+{
+  return a() + b() + own();
+}
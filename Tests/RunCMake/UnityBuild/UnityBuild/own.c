@@ -0,0 +1,2 @@
+static int value(void) { return 0; }
+int own(void) { return value(); }
@@ -0,0 +1,6 @@
+set(unity_dir "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/foo.dir/Unity")
+if(NOT EXISTS "${unity_dir}/Release/unity_0_c.c")
+  set(RunCMake_TEST_FAILED "Unity source not generated for Release.")
+elseif(EXISTS "${unity_dir}/unity_0_c.c")
+  set(RunCMake_TEST_FAILED "Unity source not named for its configuration.")
+endif()
@@ -0,0 +1,5 @@
+enable_language(C)
+
+set(CMAKE_BUILD_TYPE Release)
+add_library(foo STATIC UnityBuild/a.c UnityBuild/b.c)
+set_property(TARGET foo PROPERTY UNITY_BUILD ON)
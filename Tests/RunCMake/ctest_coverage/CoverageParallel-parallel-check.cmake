@@ -0,0 +1,34 @@
+file(GLOB coverage_xml "${RunCMake_TEST_BINARY_DIR}/Testing/*/Coverage*.xml")
+if(NOT coverage_xml)
+  set(RunCMake_TEST_FAILED "No coverage results were written.")
+  return()
+endif()
+foreach(xml IN LISTS coverage_xml)
+  get_filename_component(name "${xml}" NAME)
+  set(serial_xml "${RunCMake_TEST_BINARY_DIR}/serial/${name}")
+  if(NOT EXISTS "${serial_xml}")
+    set(RunCMake_TEST_FAILED "No serial coverage results for\n ${xml}")
+    return()
+  endif()
+  # Compare everything but the time stamps.
+  foreach(kind parallel serial)
+    if(kind STREQUAL "serial")
+      file(READ "${serial_xml}" content)
+    else()
+      file(READ "${xml}" content)
+    endif()
+    string(REGEX REPLACE "<(Start|End)[A-Za-z]*>[^<]*</(Start|End)[A-Za-z]*>" "" content "${content}")
+    string(REGEX REPLACE "<ElapsedMinutes>[^<]*</ElapsedMinutes>" "" content "${content}")
+    string(REGEX REPLACE "BuildStamp=\"[^\"]*\"" "" content "${content}")
+    set(${kind} "${content}")
+  endforeach()
+  if(NOT parallel STREQUAL serial)
+    set(RunCMake_TEST_FAILED "Parallel coverage results differ from the serial ones in\n ${xml}")
+    return()
+  endif()
+  if(xml MATCHES "/Coverage.xml$" AND
+     NOT parallel MATCHES "<File Name=\"shared.h\".*<LOCTested>[1-9]")
+    set(RunCMake_TEST_FAILED "Coverage of the shared header not found in\n ${xml}")
+    return()
+  endif()
+endforeach()
@@ -0,0 +1,42 @@
+enable_language(C)
+include(CTest)
+# Several objects include the same header so that gcov writes a .gcov
+# file for it from more than one job.
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/shared.h" "
+static int shared(int x)
+{
+  if(x > 1)
+    {
+    return x * 2;
+    }
+  return x;
+}
+")
+set(sources main.c)
+foreach(i RANGE 1 6)
+  file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/part${i}.c" "#include \"shared.h\"
+int part${i}(int x)
+{
+  if(x > ${i})
+    {
+    return shared(x);
+    }
+  return ${i};
+}
+")
+  list(APPEND sources part${i}.c)
+  set(decls "${decls}int part${i}(int);\n")
+  set(calls "${calls}  r += part${i}(argc + 2);\n")
+endforeach()
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/main.c" "${decls}
+int main(int argc, char** argv)
+{
+  int r = 0;
+  (void)argv;
+${calls}  return r == 0;
+}
+")
+add_executable(main ${sources})
+set_property(TARGET main APPEND_STRING PROPERTY COMPILE_FLAGS " --coverage -O0")
+set_property(TARGET main APPEND_STRING PROPERTY LINK_FLAGS " --coverage")
+add_test(NAME main COMMAND main)
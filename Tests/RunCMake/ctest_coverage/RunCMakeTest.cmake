@@ -8,3 +8,30 @@ function(run_ctest_coverage CASE_NAME)
 endfunction()
 
 run_ctest_coverage(CoverageQuiet QUIET)
+
+function(run_CoverageParallel)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CoverageParallel-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(CoverageParallel)
+  run_cmake_command(CoverageParallel-build ${CMAKE_COMMAND} --build .)
+  run_cmake_command(CoverageParallel-test ${CMAKE_CTEST_COMMAND})
+  run_cmake_command(CoverageParallel-serial
+    ${CMAKE_CTEST_COMMAND} -T Coverage -j1)
+  # Keep the serial results for comparison with the parallel ones.
+  # The coverage step removes old logs from the Testing directory.
+  file(GLOB coverage_xml "${RunCMake_TEST_BINARY_DIR}/Testing/*/Coverage*.xml")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}/serial")
+  foreach(xml IN LISTS coverage_xml)
+    get_filename_component(name "${xml}" NAME)
+    file(RENAME "${xml}" "${RunCMake_TEST_BINARY_DIR}/serial/${name}")
+  endforeach()
+  run_cmake_command(CoverageParallel-parallel
+    ${CMAKE_CTEST_COMMAND} -T Coverage -j4)
+endfunction()
+if(RunCMake_GENERATOR MATCHES "Make|Ninja" AND
+   CMAKE_C_COMPILER_ID STREQUAL "GNU" AND
+   COVERAGE_COMMAND MATCHES "gcov")
+  run_CoverageParallel()
+endif()
@@ -0,0 +1,62 @@
+cmake_minimum_required(VERSION 3.0)
+project(Minimal NONE)
+
+# Exercise variable lookups from deeply nested function scopes.  Every
+# level reads variables defined at the top, in an intermediate scope,
+# and never defined at all, then passes a value back with PARENT_SCOPE.
+
+set(depth 200)
+foreach(i RANGE 49)
+  set(top_var_${i} "top${i}")
+endforeach()
+set(top_overridden top)
+
+function(recurse level)
+  foreach(round RANGE 4)
+    foreach(i RANGE 49)
+      if(NOT "${top_var_${i}}" STREQUAL "top${i}")
+        message(SEND_ERROR
+          "top_var_${i} is \"${top_var_${i}}\" at level ${level}")
+      endif()
+    endforeach()
+    if(DEFINED never_defined)
+      message(SEND_ERROR "never_defined is defined at level ${level}")
+    endif()
+  endforeach()
+
+  if(level EQUAL 100)
+    set(top_overridden "level100")
+  elseif(level LESS 100 AND NOT top_overridden STREQUAL "top")
+    message(SEND_ERROR
+      "top_overridden is \"${top_overridden}\" at level ${level}")
+  elseif(level GREATER 100 AND NOT top_overridden STREQUAL "level100")
+    message(SEND_ERROR
+      "top_overridden is \"${top_overridden}\" at level ${level}")
+  endif()
+
+  if(level LESS depth)
+    math(EXPR next "${level} + 1")
+    recurse(${next})
+    if(NOT result EQUAL depth)
+      message(SEND_ERROR "result is \"${result}\" at level ${level}")
+    endif()
+    if(NOT top_overridden STREQUAL "from${next}")
+      message(SEND_ERROR
+        "top_overridden is \"${top_overridden}\" after level ${next}")
+    endif()
+    set(result "${result}" PARENT_SCOPE)
+  else()
+    set(result "${level}" PARENT_SCOPE)
+  endif()
+  # Modify the caller after it has read the value through the chain.
+  set(top_overridden "from${level}" PARENT_SCOPE)
+endfunction()
+
+recurse(1)
+
+if(NOT result EQUAL depth)
+  message(SEND_ERROR "result is \"${result}\" at top")
+endif()
+if(NOT top_overridden STREQUAL "from1")
+  message(SEND_ERROR "top_overridden is \"${top_overridden}\" at top")
+endif()
@@ -3,3 +3,4 @@ include(RunCMake)
 run_cmake(ParentScope)
 run_cmake(ParentPulling)
 run_cmake(ParentPullingRecursive)
+run_cmake(DeepRecursion)